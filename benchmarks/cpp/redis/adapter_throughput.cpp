@@ -0,0 +1,113 @@
+/* Copyright (c) 2018-2024 Marcelo Zimbres Silva (mzimbres@gmail.com)
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See
+ * accompanying file LICENSE.txt)
+ */
+
+#include <boost/redis/resp3/parser.hpp>
+#include <boost/redis/adapter/adapt.hpp>
+#include <boost/redis/detail/any_adapter.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace resp3 = boost::redis::resp3;
+using boost::redis::response;
+using boost::redis::adapter::boost_redis_adapt;
+using boost::redis::detail::any_adapter;
+using boost::system::error_code;
+
+// Time needed to read large aggregates into a response, passing the
+// nodes to the adapter one by one through a std::function, as the
+// connection did before, through any_adapter, and letting any_adapter
+// run the parse loop. Run with
+//
+//    $ ./adapter_throughput [repetitions]
+
+namespace {
+
+using node_type = resp3::basic_node<std::string_view>;
+
+// The reply to LRANGE on a list of counters.
+auto make_int_array(std::size_t n)
+{
+   std::string ret = "*" + std::to_string(n) + "\r\n";
+   for (std::size_t i = 0; i < n; ++i)
+      ret += ":" + std::to_string(i % 1000) + "\r\n";
+   return ret;
+}
+
+// The reply to ZRANGE on a set with short members.
+auto make_bulk_array(std::size_t n)
+{
+   std::string ret = "*" + std::to_string(n) + "\r\n";
+   for (std::size_t i = 0; i < n; ++i) {
+      auto const member = "member:" + std::to_string(i);
+      ret += "$" + std::to_string(member.size()) + "\r\n" + member + "\r\n";
+   }
+   return ret;
+}
+
+// The response is at index one, as if the request had a command
+// before the one being measured.
+template <class T>
+void run(char const* name, std::string const& wire, int reps)
+{
+   std::printf("%s (%zu bytes)\n", name, wire.size());
+
+   auto measure = [&](char const* what, auto parse) {
+      response<int, T> resp;
+      std::size_t elems = 0;
+
+      auto const begin = std::chrono::steady_clock::now();
+      for (int i = 0; i < reps; ++i) {
+         std::get<1>(resp).value().clear();
+         resp3::parser p;
+         error_code ec;
+         if (!parse(resp, p, ec) || ec) {
+            std::fprintf(stderr, "Error: %s\n", ec.message().data());
+            return;
+         }
+         elems += std::get<1>(resp).value().size();
+      }
+      auto const end = std::chrono::steady_clock::now();
+
+      std::chrono::duration<double> const secs = end - begin;
+      std::printf("   %-12s %8.1f M elements/s\n", what, static_cast<double>(elems) / secs.count() / 1e6);
+   };
+
+   measure("function", [&](auto& resp, resp3::parser& p, error_code& ec) {
+      std::function<void(std::size_t, node_type const&, error_code&)> f = boost_redis_adapt(resp);
+      auto adapter = [&f](node_type const& nd, error_code& ec2) { f(1, nd, ec2); };
+      return resp3::parse(p, wire, adapter, ec);
+   });
+
+   measure("per node", [&](auto& resp, resp3::parser& p, error_code& ec) {
+      any_adapter f;
+      f.emplace(boost_redis_adapt(resp));
+      auto adapter = [&f](node_type const& nd, error_code& ec2) { f(1, nd, ec2); };
+      return resp3::parse(p, wire, adapter, ec);
+   });
+
+   measure("per message", [&](auto& resp, resp3::parser& p, error_code& ec) {
+      any_adapter f;
+      f.emplace(boost_redis_adapt(resp));
+      return f.parse(1, p, wire, ec);
+   });
+}
+
+} // anonymous
+
+int main(int argc, char* argv[])
+{
+   int reps = 20;
+   if (argc == 2)
+      reps = std::stoi(argv[1]);
+
+   run<std::vector<int>>("LRANGE into std::vector<int>", make_int_array(1'000'000), reps);
+   run<std::vector<std::string>>("ZRANGE into std::vector<std::string>", make_bulk_array(1'000'000), reps);
+}
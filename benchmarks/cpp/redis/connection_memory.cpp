@@ -0,0 +1,80 @@
+/* Copyright (c) 2018-2024 Marcelo Zimbres Silva (mzimbres@gmail.com)
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See
+ * accompanying file LICENSE.txt)
+ */
+
+#include <boost/redis/connection.hpp>
+#include <boost/asio/io_context.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <vector>
+
+namespace net = boost::asio;
+using boost::redis::basic_connection;
+using boost::redis::basic_tcp_connection;
+
+// Memory used per connection by the default connection, that has an
+// SSL layer, and by a connection over a plain TCP socket. Counts the
+// size of the object plus what it allocates on construction, i.e.
+// before any I/O happens. Run with
+//
+//    $ ./connection_memory
+
+namespace {
+
+std::size_t allocated = 0;
+
+} // anonymous
+
+void* operator new(std::size_t n)
+{
+   allocated += n;
+
+   if (auto* p = std::malloc(n == 0 ? 1 : n))
+      return p;
+
+   throw std::bad_alloc{};
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+template <class Connection>
+auto measure(net::io_context& ioc, std::size_t n)
+{
+   std::vector<std::unique_ptr<Connection>> conns;
+   conns.reserve(n);
+
+   auto const before = allocated;
+   for (std::size_t i = 0; i < n; ++i)
+      conns.push_back(std::make_unique<Connection>(ioc));
+
+   // OpenSSL allocates with malloc and is not counted.
+   return (allocated - before) / n;
+}
+
+template <class Connection>
+void print(char const* name, net::io_context& ioc, std::size_t n)
+{
+   std::printf("%8s %10zu %16zu\n", name, sizeof(Connection), measure<Connection>(ioc, n));
+}
+
+} // anonymous
+
+int main()
+{
+   using executor_type = net::io_context::executor_type;
+
+   net::io_context ioc;
+   std::size_t const n = 10'000;
+
+   std::printf("%8s %10s %16s\n", "stream", "sizeof", "heap (bytes)");
+   print<basic_connection<executor_type>>("tls", ioc, n);
+   print<basic_tcp_connection<executor_type>>("tcp", ioc, n);
+}
@@ -0,0 +1,122 @@
+/* Copyright (c) 2018-2024 Marcelo Zimbres Silva (mzimbres@gmail.com)
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See
+ * accompanying file LICENSE.txt)
+ */
+
+#include <boost/redis/resp3/parser.hpp>
+#include <boost/redis/adapter/adapt.hpp>
+#include <boost/redis/adapter/boost_containers.hpp>
+#include <boost/container/flat_map.hpp>
+#include <boost/container/flat_set.hpp>
+#include <boost/version.hpp>
+
+#if BOOST_VERSION >= 108200
+#include <boost/unordered/unordered_flat_map.hpp>
+#include <boost/unordered/unordered_flat_set.hpp>
+#endif
+
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace resp3 = boost::redis::resp3;
+using boost::redis::adapter::adapt2;
+using boost::redis::adapter::result;
+using boost::system::error_code;
+
+// Time needed to read the replies to HGETALL and SMEMBERS into the
+// standard containers and into the flat and open-addressing
+// containers of Boost. Run with
+//
+//    $ ./container_adapters [repetitions]
+
+namespace {
+
+auto make_bulk(std::string const& s)
+{
+   return "$" + std::to_string(s.size()) + "\r\n" + s + "\r\n";
+}
+
+// Field names of a hash are received in no particular order.
+auto make_hgetall(std::size_t n)
+{
+   std::string ret = "%" + std::to_string(n) + "\r\n";
+   for (std::size_t i = 0; i < n; ++i) {
+      auto const k = (i * 7919) % n;
+      ret += make_bulk("field:" + std::to_string(k));
+      ret += make_bulk("value:" + std::to_string(k));
+   }
+   return ret;
+}
+
+auto make_smembers(std::size_t n)
+{
+   std::string ret = "~" + std::to_string(n) + "\r\n";
+   for (std::size_t i = 0; i < n; ++i)
+      ret += make_bulk("member:" + std::to_string((i * 7919) % n));
+   return ret;
+}
+
+template <class Container>
+void measure(char const* name, std::string const& wire, int reps)
+{
+   std::size_t elems = 0;
+
+   auto const begin = std::chrono::steady_clock::now();
+   for (int i = 0; i < reps; ++i) {
+      result<Container> resp;
+      auto adapter = adapt2(resp);
+      resp3::parser p;
+      error_code ec;
+      if (!resp3::parse(p, wire, adapter, ec) || ec) {
+         std::fprintf(stderr, "Error: %s\n", ec.message().data());
+         return;
+      }
+      elems += resp.value().size();
+   }
+   auto const end = std::chrono::steady_clock::now();
+
+   std::chrono::duration<double, std::micro> const us = end - begin;
+   std::printf("   %-30s %7zu elements %10.1f us/reply\n", name, elems / reps, us.count() / reps);
+}
+
+void run(std::size_t n, int reps)
+{
+   using str = std::string;
+
+   auto const hgetall = make_hgetall(n);
+   std::printf("HGETALL with %zu fields\n", n);
+   measure<std::map<str, str>>("std::map", hgetall, reps);
+   measure<std::unordered_map<str, str>>("std::unordered_map", hgetall, reps);
+   measure<boost::container::flat_map<str, str>>("boost::container::flat_map", hgetall, reps);
+#if BOOST_VERSION >= 108200
+   measure<boost::unordered_flat_map<str, str>>("boost::unordered_flat_map", hgetall, reps);
+#endif
+
+   auto const smembers = make_smembers(n);
+   std::printf("SMEMBERS with %zu members\n", n);
+   measure<std::set<str>>("std::set", smembers, reps);
+   measure<std::unordered_set<str>>("std::unordered_set", smembers, reps);
+   measure<boost::container::flat_set<str>>("boost::container::flat_set", smembers, reps);
+#if BOOST_VERSION >= 108200
+   measure<boost::unordered_flat_set<str>>("boost::unordered_flat_set", smembers, reps);
+#endif
+}
+
+} // anonymous
+
+int main(int argc, char* argv[])
+{
+   int reps = 1000;
+   if (argc == 2)
+      reps = std::stoi(argv[1]);
+
+   run(100, reps);
+   run(1'000, reps);
+   run(10'000, reps / 10 + 1);
+}
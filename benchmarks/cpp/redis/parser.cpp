@@ -0,0 +1,129 @@
+/* Copyright (c) 2018-2024 Marcelo Zimbres Silva (mzimbres@gmail.com)
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See
+ * accompanying file LICENSE.txt)
+ */
+
+#include <boost/redis/resp3/parser.hpp>
+#include <boost/redis/resp3/detail/crlf_index.hpp>
+#include <boost/redis/adapter/adapt.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace resp3 = boost::redis::resp3;
+using resp3::detail::crlf_scanner;
+using boost::system::error_code;
+
+// Parse throughput for each of the separator scanners. Run with
+//
+//    $ ./parser_throughput [repetitions]
+
+namespace {
+
+auto to_string(crlf_scanner s) -> char const*
+{
+   switch (s) {
+      case crlf_scanner::scalar: return "scalar";
+      case crlf_scanner::sse2: return "sse2";
+      case crlf_scanner::avx2: return "avx2";
+      case crlf_scanner::neon: return "neon";
+      default: return "automatic";
+   }
+}
+
+// A pipeline of simple replies as received by a connection that sent
+// many PINGs.
+auto make_pings(std::size_t n)
+{
+   std::string ret;
+   for (std::size_t i = 0; i < n; ++i)
+      ret += "+PONG\r\n";
+   return ret;
+}
+
+// A single array of small integers e.g. the reply to LRANGE on a
+// list of counters.
+auto make_int_array(std::size_t n)
+{
+   std::string ret = "*" + std::to_string(n) + "\r\n";
+   for (std::size_t i = 0; i < n; ++i)
+      ret += ":" + std::to_string(i % 1000) + "\r\n";
+   return ret;
+}
+
+// Bulk strings of moderate size, where most bytes don't have to be
+// looked at.
+auto make_bulks(std::size_t n)
+{
+   std::string const value(200, 'x');
+   std::string ret;
+   for (std::size_t i = 0; i < n; ++i)
+      ret += "$" + std::to_string(value.size()) + "\r\n" + value + "\r\n";
+   return ret;
+}
+
+// Parses all messages in the buffer the same way the connection
+// does, i.e. removing each message from the front before parsing the
+// next.
+auto parse_all(resp3::parser& p, std::string_view buffer) -> std::size_t
+{
+   auto adapter = [](auto const&, error_code&) {};
+   std::size_t msgs = 0;
+   error_code ec;
+   while (!buffer.empty() && resp3::parse(p, buffer, adapter, ec)) {
+      if (ec) {
+         std::fprintf(stderr, "Error: %s\n", ec.message().data());
+         return msgs;
+      }
+
+      buffer.remove_prefix(p.get_consumed());
+      p.reset_for_next_message();
+      ++msgs;
+   }
+
+   return msgs;
+}
+
+void run(char const* name, std::string const& wire, int reps)
+{
+   std::printf("%s (%zu bytes)\n", name, wire.size());
+
+   for (auto s: {crlf_scanner::scalar, crlf_scanner::sse2, crlf_scanner::avx2, crlf_scanner::neon}) {
+      if (!resp3::detail::is_supported(s))
+         continue;
+
+      resp3::detail::set_crlf_scanner(s);
+
+      resp3::parser p;
+      std::size_t msgs = 0;
+      auto const begin = std::chrono::steady_clock::now();
+      for (int i = 0; i < reps; ++i) {
+         p.reset();
+         msgs += parse_all(p, wire);
+      }
+      auto const end = std::chrono::steady_clock::now();
+
+      std::chrono::duration<double> const secs = end - begin;
+      double const gbps = static_cast<double>(wire.size()) * reps / secs.count() / 1e9;
+      std::printf("   %-9s %8.3f GB/s (%zu messages)\n", to_string(s), gbps, msgs);
+   }
+
+   resp3::detail::set_crlf_scanner(crlf_scanner::automatic);
+}
+
+} // anonymous
+
+int main(int argc, char* argv[])
+{
+   int reps = 100;
+   if (argc == 2)
+      reps = std::stoi(argv[1]);
+
+   run("Pipelined +PONG", make_pings(10'000), reps);
+   run("Array of integers", make_int_array(100'000), reps);
+   run("Pipelined bulk strings", make_bulks(10'000), reps);
+}
@@ -0,0 +1,159 @@
+/* Copyright (c) 2018-2024 Marcelo Zimbres Silva (mzimbres@gmail.com)
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See
+ * accompanying file LICENSE.txt)
+ */
+
+#include <boost/redis/resp3/parser.hpp>
+#include <boost/redis/adapter/adapt.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+
+// libc++ provides std::pmr from LLVM 16 on.
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+#endif
+
+namespace resp3 = boost::redis::resp3;
+using boost::redis::adapter::adapt2;
+using boost::redis::adapter::result;
+using boost::system::error_code;
+
+// Time and heap allocations needed to read the replies to LRANGE and
+// HGETALL into std::pmr containers that allocate from the heap, as
+// std::allocator does, and from a monotonic arena, released after each
+// reply as a request-scoped handler would. Heap allocations are
+// counted by the memory resource the containers and the arena
+// allocate from. Run with
+//
+//    $ ./pmr_responses [repetitions]
+
+#if defined(__cpp_lib_memory_resource)
+
+namespace {
+
+// Counts the allocations passed on to the heap.
+class counting_resource : public std::pmr::memory_resource {
+public:
+   std::size_t allocations = 0;
+
+private:
+   auto do_allocate(std::size_t n, std::size_t align) -> void* override
+   {
+      ++allocations;
+      return std::pmr::new_delete_resource()->allocate(n, align);
+   }
+
+   void do_deallocate(void* p, std::size_t n, std::size_t align) override
+      { std::pmr::new_delete_resource()->deallocate(p, n, align); }
+
+   auto do_is_equal(std::pmr::memory_resource const& other) const noexcept -> bool override
+      { return this == &other; }
+};
+
+auto make_bulk(std::string const& s)
+{
+   return "$" + std::to_string(s.size()) + "\r\n" + s + "\r\n";
+}
+
+// Values are longer than the small string buffer.
+auto make_value(std::size_t i)
+{
+   return "value:" + std::to_string(i) + std::string(32, 'x');
+}
+
+auto make_lrange(std::size_t n)
+{
+   std::string ret = "*" + std::to_string(n) + "\r\n";
+   for (std::size_t i = 0; i < n; ++i)
+      ret += make_bulk(make_value(i));
+   return ret;
+}
+
+auto make_hgetall(std::size_t n)
+{
+   std::string ret = "%" + std::to_string(n) + "\r\n";
+   for (std::size_t i = 0; i < n; ++i) {
+      ret += make_bulk("field:" + std::to_string((i * 7919) % n) + std::string(32, 'f'));
+      ret += make_bulk(make_value(i));
+   }
+   return ret;
+}
+
+// make_container is called for each reply with the heap and the
+// arena, which is released after the reply has been read.
+template <class Container, class F>
+void measure(char const* name, std::string const& wire, int reps, F make_container)
+{
+   counting_resource heap;
+   std::pmr::monotonic_buffer_resource arena{&heap};
+
+   auto const begin = std::chrono::steady_clock::now();
+   for (int i = 0; i < reps; ++i) {
+      {
+         result<Container> resp{make_container(heap, arena)};
+         auto adapter = adapt2(resp);
+         resp3::parser p;
+         error_code ec;
+         if (!resp3::parse(p, wire, adapter, ec) || ec) {
+            std::fprintf(stderr, "Error: %s\n", ec.message().data());
+            return;
+         }
+      }
+      arena.release();
+   }
+   auto const end = std::chrono::steady_clock::now();
+
+   std::chrono::duration<double, std::micro> const us = end - begin;
+   std::printf("   %-20s %10.1f us/reply %10zu allocations/reply\n", name,
+      us.count() / reps, heap.allocations / reps);
+}
+
+void run(std::size_t n, int reps)
+{
+   using vector_type = std::pmr::vector<std::pmr::string>;
+   using map_type = std::pmr::map<std::pmr::string, std::pmr::string>;
+
+   auto const lrange = make_lrange(n);
+   std::printf("LRANGE with %zu elements into std::pmr::vector<std::pmr::string>\n", n);
+
+   measure<vector_type>("heap", lrange, reps,
+      [](auto& heap, auto&) { return vector_type{&heap}; });
+
+   measure<vector_type>("monotonic arena", lrange, reps,
+      [](auto&, auto& arena) { return vector_type{&arena}; });
+
+   auto const hgetall = make_hgetall(n);
+   std::printf("HGETALL with %zu fields into std::pmr::map<std::pmr::string, std::pmr::string>\n", n);
+
+   measure<map_type>("heap", hgetall, reps,
+      [](auto& heap, auto&) { return map_type{&heap}; });
+
+   measure<map_type>("monotonic arena", hgetall, reps,
+      [](auto&, auto& arena) { return map_type{&arena}; });
+}
+
+} // anonymous
+
+int main(int argc, char* argv[])
+{
+   int reps = 200;
+   if (argc == 2)
+      reps = std::stoi(argv[1]);
+
+   run(100, reps);
+   run(10'000, reps / 10 + 1);
+}
+
+#else
+
+int main()
+{
+   std::printf("std::pmr is not provided by this standard library\n");
+}
+
+#endif // defined(__cpp_lib_memory_resource)
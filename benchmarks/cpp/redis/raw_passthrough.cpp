@@ -0,0 +1,125 @@
+/* Copyright (c) 2018-2024 Marcelo Zimbres Silva (mzimbres@gmail.com)
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See
+ * accompanying file LICENSE.txt)
+ */
+
+#include <boost/redis/response.hpp>
+#include <boost/redis/resp3/parser.hpp>
+#include <boost/redis/resp3/serialization.hpp>
+#include <boost/redis/adapter/adapt.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <string_view>
+
+namespace resp3 = boost::redis::resp3;
+using boost::redis::adapter::adapt2;
+using boost::redis::generic_response;
+using boost::redis::raw_response;
+using boost::system::error_code;
+
+// Time needed to forward the replies to LRANGE and HGETALL as a
+// proxy does, either by decoding them into a generic_response and
+// serializing the nodes again or by keeping their bytes in a
+// raw_response. Run with
+//
+//    $ ./raw_passthrough [repetitions]
+
+namespace {
+
+auto make_bulk(std::string const& s)
+{
+   return "$" + std::to_string(s.size()) + "\r\n" + s + "\r\n";
+}
+
+auto make_value(std::size_t i)
+{
+   return "value:" + std::to_string(i) + std::string(32, 'x');
+}
+
+auto make_lrange(std::size_t n)
+{
+   std::string ret = "*" + std::to_string(n) + "\r\n";
+   for (std::size_t i = 0; i < n; ++i)
+      ret += make_bulk(make_value(i));
+   return ret;
+}
+
+auto make_hgetall(std::size_t n)
+{
+   std::string ret = "%" + std::to_string(n) + "\r\n";
+   for (std::size_t i = 0; i < n; ++i) {
+      ret += make_bulk("field:" + std::to_string(i));
+      ret += make_bulk(make_value(i));
+   }
+   return ret;
+}
+
+// Only the types in the replies above are serialized.
+void serialize(std::string& out, generic_response const& resp)
+{
+   for (auto const& nd: resp.value()) {
+      if (resp3::is_aggregate(nd.data_type))
+         resp3::add_header(out, nd.data_type, nd.aggregate_size);
+      else
+         resp3::boost_redis_to_bulk(out, nd.value);
+   }
+}
+
+template <class Response, class F>
+void measure(char const* name, std::string const& wire, int reps, F forward)
+{
+   std::string out;
+   Response resp;
+
+   auto const begin = std::chrono::steady_clock::now();
+   for (int i = 0; i < reps; ++i) {
+      resp.value().clear();
+      out.clear();
+
+      auto adapter = adapt2(resp);
+      resp3::parser p;
+      error_code ec;
+      if (!resp3::parse(p, wire, adapter, ec) || ec) {
+         std::fprintf(stderr, "Error: %s\n", ec.message().data());
+         return;
+      }
+
+      forward(out, resp);
+   }
+   auto const end = std::chrono::steady_clock::now();
+
+   if (out != wire) {
+      std::fprintf(stderr, "Error: %s doesn't forward the reply verbatim\n", name);
+      return;
+   }
+
+   std::chrono::duration<double, std::micro> const us = end - begin;
+   std::printf("   %-20s %10.1f us/reply\n", name, us.count() / reps);
+}
+
+void run(char const* title, std::string const& wire, int reps)
+{
+   std::printf("%s (%zu bytes)\n", title, wire.size());
+
+   measure<generic_response>("generic_response", wire, reps,
+      [](std::string& out, generic_response const& resp) { serialize(out, resp); });
+
+   measure<raw_response>("raw_response", wire, reps,
+      [](std::string& out, raw_response const& resp) { out.append(resp.value().get_data()); });
+}
+
+} // anonymous
+
+int main(int argc, char* argv[])
+{
+   int reps = 200;
+   if (argc == 2)
+      reps = std::stoi(argv[1]);
+
+   run("LRANGE with 100 elements", make_lrange(100), reps);
+   run("LRANGE with 10000 elements", make_lrange(10'000), reps / 10 + 1);
+   run("HGETALL with 10000 fields", make_hgetall(10'000), reps / 10 + 1);
+}
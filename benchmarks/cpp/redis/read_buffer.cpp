@@ -0,0 +1,110 @@
+/* Copyright (c) 2018-2024 Marcelo Zimbres Silva (mzimbres@gmail.com)
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See
+ * accompanying file LICENSE.txt)
+ */
+
+#include <boost/redis/resp3/parser.hpp>
+#include <boost/redis/detail/read_buffer.hpp>
+#include <boost/asio/buffer.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <string_view>
+
+namespace asio = boost::asio;
+namespace resp3 = boost::redis::resp3;
+using boost::redis::detail::read_buffer;
+using boost::system::error_code;
+
+// Cost of parsing a burst of pipelined replies received in a single
+// read as a function of the pipeline depth. Compares erasing each
+// message from the front of a std::string (what the connection did
+// before) with the offset-based read_buffer. Run with
+//
+//    $ ./read_buffer_burst
+
+namespace {
+
+auto make_burst(std::size_t depth)
+{
+   std::string ret;
+   for (std::size_t i = 0; i < depth; ++i)
+      ret += "$5\r\nhello\r\n";
+   return ret;
+}
+
+template <class Buffer, class View, class Append>
+auto parse_burst(Buffer& buf, View view, Append append, std::string_view burst) -> std::size_t
+{
+   auto adapter = [](auto const&, error_code&) {};
+   resp3::parser p;
+   std::size_t msgs = 0;
+   error_code ec;
+
+   append(buf, burst);
+   while (resp3::parse(p, view(buf), adapter, ec)) {
+      buf.consume(p.get_consumed());
+      p.reset_for_next_message();
+      ++msgs;
+      if (view(buf).empty())
+         break;
+   }
+
+   return msgs;
+}
+
+template <class F>
+auto measure(std::size_t reps, F f)
+{
+   auto const begin = std::chrono::steady_clock::now();
+   for (std::size_t i = 0; i < reps; ++i)
+      f();
+   auto const end = std::chrono::steady_clock::now();
+   return std::chrono::duration<double, std::nano>(end - begin).count() / reps;
+}
+
+} // anonymous
+
+int main()
+{
+   std::printf("%10s %16s %20s\n", "depth", "string (ns/msg)", "read_buffer (ns/msg)");
+
+   for (std::size_t depth: {1, 10, 100, 1'000, 10'000, 100'000}) {
+      auto const burst = make_burst(depth);
+      auto const reps = (std::max)(std::size_t{1}, std::size_t{1'000'000} / depth);
+
+      std::string str;
+      auto before = [&]()
+      {
+         auto dbuf = asio::dynamic_buffer(str);
+         auto view = [](auto& b) { return std::string_view{static_cast<char const*>(b.data(0, b.size()).data()), b.size()}; };
+         auto append = [](auto& b, std::string_view data)
+         {
+            auto const size = b.size();
+            b.grow(data.size());
+            asio::buffer_copy(b.data(size, data.size()), asio::buffer(data));
+         };
+         parse_burst(dbuf, view, append, burst);
+      };
+
+      read_buffer rbuf;
+      auto after = [&]()
+      {
+         auto view = [](read_buffer const& b) { return b.view(); };
+         auto append = [](read_buffer& b, std::string_view data)
+         {
+            auto const size = b.size();
+            b.grow(data.size());
+            asio::buffer_copy(b.data(size, data.size()), asio::buffer(data));
+         };
+         parse_burst(rbuf, view, append, burst);
+      };
+
+      auto const t0 = measure(reps, before) / depth;
+      auto const t1 = measure(reps, after) / depth;
+      std::printf("%10zu %16.1f %20.1f\n", depth, t0, t1);
+   }
+}
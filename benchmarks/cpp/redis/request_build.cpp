@@ -0,0 +1,76 @@
+/* Copyright (c) 2018-2024 Marcelo Zimbres Silva (mzimbres@gmail.com)
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See
+ * accompanying file LICENSE.txt)
+ */
+
+#include <boost/redis/request.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+using boost::redis::command_template;
+using boost::redis::request;
+
+// Number of requests built per second with the usual push and with
+// command templates, for some typical command shapes. The request is
+// cleared and reused, as applications do on the hot path. Run with
+//
+//    $ ./request_build
+
+namespace {
+
+constexpr command_template<1> get{"GET"};
+constexpr command_template<4> set_ex{"SET"};
+constexpr command_template<3> hincrby{"HINCRBY"};
+
+std::string const key = "user:1234:session";
+std::string const value = "some-session-token-value";
+
+template <class F>
+auto measure(F f, std::size_t n)
+{
+   request req;
+
+   auto const begin = std::chrono::steady_clock::now();
+   for (std::size_t i = 0; i < n; ++i) {
+      req.clear();
+      f(req);
+   }
+   auto const end = std::chrono::steady_clock::now();
+
+   // Keeps the work from being optimized away.
+   if (req.get_commands() != 1)
+      std::printf("unexpected\n");
+
+   return n / std::chrono::duration<double>(end - begin).count();
+}
+
+template <class F, class G>
+void compare(char const* name, F f, G g)
+{
+   std::size_t const n = 10'000'000;
+   auto const t0 = measure(f, n);
+   auto const t1 = measure(g, n);
+   std::printf("%18s %16.2f %16.2f\n", name, t0 / 1e6, t1 / 1e6);
+}
+
+} // anonymous
+
+int main()
+{
+   std::printf("%18s %16s %16s\n", "command", "push (M/s)", "template (M/s)");
+
+   compare("GET k",
+      [](request& req) { req.push("GET", key); },
+      [](request& req) { req.push(get, key); });
+
+   compare("SET k v EX n",
+      [](request& req) { req.push("SET", key, value, "EX", 60); },
+      [](request& req) { req.push(set_ex, key, value, "EX", 60); });
+
+   compare("HINCRBY h f n",
+      [](request& req) { req.push("HINCRBY", key, "field", 1); },
+      [](request& req) { req.push(hincrby, key, "field", 1); });
+}
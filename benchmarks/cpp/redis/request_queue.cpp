@@ -0,0 +1,149 @@
+/* Copyright (c) 2018-2024 Marcelo Zimbres Silva (mzimbres@gmail.com)
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See
+ * accompanying file LICENSE.txt)
+ */
+
+#include <boost/redis/detail/intrusive_list.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <vector>
+
+using boost::redis::detail::intrusive_list;
+using boost::redis::detail::list_hook;
+
+// Cost of the bookkeeping the connection does per request as a
+// function of the number of requests in flight. Each cycle adds a
+// request, writes it and reads the response to the oldest one, like a
+// connection under steady load. Compares the algorithms used on a
+// std::deque of shared pointers (what the connection did before) with
+// the intrusive queue split in segments. Run with
+//
+//    $ ./request_queue_depth
+
+namespace {
+
+enum class status { waiting, staged, written };
+
+struct node : list_hook {
+   status st = status::waiting;
+   std::size_t expected_responses = 1;
+};
+
+struct deque_queue {
+   std::deque<std::shared_ptr<node>> reqs;
+
+   void add()
+      { reqs.push_back(std::make_shared<node>()); }
+
+   void write()
+   {
+      auto const point = std::partition_point(std::cbegin(reqs), std::cend(reqs), [](auto const& p) {
+         return p->st != status::waiting;
+      });
+
+      std::for_each(point, std::cend(reqs), [](auto const& p) { p->st = status::staged; });
+
+      // on_write: cancel_push_requests followed by the status update.
+      auto const push = std::stable_partition(std::begin(reqs), std::end(reqs), [](auto const& p) {
+         return !(p->st == status::staged && p->expected_responses == 0);
+      });
+
+      reqs.erase(push, std::end(reqs));
+
+      std::for_each(std::begin(reqs), std::end(reqs), [](auto const& p) {
+         if (p->st == status::staged)
+            p->st = status::written;
+      });
+   }
+
+   void read()
+      { reqs.pop_front(); }
+};
+
+struct segmented_queue {
+   std::vector<node> pool;
+   std::vector<node*> free;
+   intrusive_list<node> written;
+   intrusive_list<node> staged;
+   intrusive_list<node> waiting;
+
+   explicit segmented_queue(std::size_t n)
+   : pool(n + 1)
+   {
+      for (auto& nd: pool)
+         free.push_back(&nd);
+   }
+
+   void add()
+   {
+      auto* nd = free.back();
+      free.pop_back();
+      nd->st = status::waiting;
+      waiting.push_back(*nd);
+   }
+
+   void write()
+   {
+      waiting.for_each([](node& nd) { nd.st = status::staged; });
+      staged.splice_back(waiting);
+
+      staged.for_each([this](node& nd) {
+         if (nd.expected_responses == 0) {
+            intrusive_list<node>::unlink(nd);
+            free.push_back(&nd);
+         }
+      });
+
+      staged.for_each([](node& nd) { nd.st = status::written; });
+      written.splice_back(staged);
+   }
+
+   void read()
+   {
+      auto& nd = written.front();
+      intrusive_list<node>::unlink(nd);
+      free.push_back(&nd);
+   }
+};
+
+template <class Queue>
+auto measure(Queue& q, std::size_t depth, std::size_t cycles)
+{
+   for (std::size_t i = 0; i < depth; ++i)
+      q.add();
+   q.write();
+
+   auto const begin = std::chrono::steady_clock::now();
+   for (std::size_t i = 0; i < cycles; ++i) {
+      q.add();
+      q.write();
+      q.read();
+   }
+   auto const end = std::chrono::steady_clock::now();
+
+   return std::chrono::duration<double, std::nano>(end - begin).count() / cycles;
+}
+
+} // anonymous
+
+int main()
+{
+   std::printf("%10s %18s %20s\n", "in-flight", "deque (ns/req)", "segmented (ns/req)");
+
+   for (std::size_t depth: {1, 10, 100, 1'000, 10'000, 100'000}) {
+      auto const cycles = (std::max)(std::size_t{1'000}, std::size_t{10'000'000} / depth);
+
+      deque_queue dq;
+      auto const t0 = measure(dq, depth, cycles);
+
+      segmented_queue sq{depth};
+      auto const t1 = measure(sq, depth, cycles);
+
+      std::printf("%10zu %18.1f %20.1f\n", depth, t0, t1);
+   }
+}
@@ -0,0 +1,95 @@
+/* Copyright (c) 2018-2024 Marcelo Zimbres Silva (mzimbres@gmail.com)
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See
+ * accompanying file LICENSE.txt)
+ */
+
+#include <boost/redis/request.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using boost::redis::request;
+
+// Time and allocations needed to build a ZADD with one million
+// members, passing the scores as doubles and, as was necessary
+// before they were supported, formatting them into temporary strings
+// first. Run with
+//
+//    $ ./zadd_build
+
+namespace {
+
+std::size_t allocations = 0;
+
+} // anonymous
+
+void* operator new(std::size_t n)
+{
+   ++allocations;
+
+   if (auto* p = std::malloc(n == 0 ? 1 : n))
+      return p;
+
+   throw std::bad_alloc{};
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+std::size_t const members = 1'000'000;
+
+template <class F>
+void measure(char const* name, F f)
+{
+   request req;
+
+   auto const allocs = allocations;
+   auto const begin = std::chrono::steady_clock::now();
+   f(req);
+   auto const end = std::chrono::steady_clock::now();
+
+   std::printf("%18s %12.1f %14zu %14zu\n", name,
+      std::chrono::duration<double, std::milli>(end - begin).count(),
+      allocations - allocs,
+      std::size(req.payload()));
+}
+
+} // anonymous
+
+int main()
+{
+   std::vector<std::pair<double, std::string>> zset;
+   zset.reserve(members);
+   for (std::size_t i = 0; i < members; ++i)
+      zset.emplace_back(i * 0.37, "member:" + std::to_string(i));
+
+   std::printf("%18s %12s %14s %14s\n", "scores", "time (ms)", "allocations", "payload");
+
+   measure("double", [&](request& req) {
+      req.push_range("ZADD", "zset", zset);
+   });
+
+   measure("temporary string", [&](request& req) {
+      std::ostringstream os;
+      os.precision(17);
+
+      std::vector<std::pair<std::string, std::string_view>> tmp;
+      tmp.reserve(members);
+      for (auto const& [score, member]: zset) {
+         os.str({});
+         os << score;
+         tmp.emplace_back(os.str(), member);
+      }
+
+      req.push_range("ZADD", "zset", tmp);
+   });
+}
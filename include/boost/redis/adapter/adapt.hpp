@@ -27,7 +27,8 @@ namespace boost::redis::adapter
  *  The type T must be either
  *
  *  1. a response<T1, T2, T3, ...> or
- *  2. std::vector<node<String>>
+ *  2. std::vector<node<String>> or
+ *  3. flat_response
  *
  *  The types T1, T2, etc can be any STL container, any integer type
  *  and `std::string`.
@@ -0,0 +1,88 @@
+/* Copyright (c) 2018-2024 Marcelo Zimbres Silva (mzimbres@gmail.com)
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See
+ * accompanying file LICENSE.txt)
+ */
+
+#ifndef BOOST_REDIS_ADAPTER_BOOST_CONTAINERS_HPP
+#define BOOST_REDIS_ADAPTER_BOOST_CONTAINERS_HPP
+
+#include <boost/redis/adapter/container.hpp>
+#include <boost/container/container_fwd.hpp>
+#include <boost/version.hpp>
+
+#if BOOST_VERSION >= 108200
+#include <boost/unordered/unordered_flat_map_fwd.hpp>
+#include <boost/unordered/unordered_flat_set_fwd.hpp>
+#include <boost/unordered/unordered_node_map_fwd.hpp>
+#include <boost/unordered/unordered_node_set_fwd.hpp>
+#endif
+
+#include <cstddef>
+
+// Allows the containers of Boost.Container and the open-addressing
+// containers of Boost.Unordered to be used as responses, see
+// boost::redis::adapter::container_category. Including this header
+// doesn't require the containers to be included.
+
+namespace boost::redis::adapter
+{
+
+template <class... Ts>
+struct container_category<boost::container::vector<Ts...>> { using type = sequence_container_tag; };
+
+template <class... Ts>
+struct container_category<boost::container::stable_vector<Ts...>> { using type = sequence_container_tag; };
+
+template <class T, std::size_t N, class... Ts>
+struct container_category<boost::container::small_vector<T, N, Ts...>> { using type = sequence_container_tag; };
+
+template <class T, std::size_t N, class... Ts>
+struct container_category<boost::container::static_vector<T, N, Ts...>> { using type = sequence_container_tag; };
+
+template <class... Ts>
+struct container_category<boost::container::deque<Ts...>> { using type = sequence_container_tag; };
+
+template <class... Ts>
+struct container_category<boost::container::set<Ts...>> { using type = set_container_tag; };
+
+template <class... Ts>
+struct container_category<boost::container::multiset<Ts...>> { using type = set_container_tag; };
+
+template <class... Ts>
+struct container_category<boost::container::flat_set<Ts...>> { using type = set_container_tag; };
+
+template <class... Ts>
+struct container_category<boost::container::flat_multiset<Ts...>> { using type = set_container_tag; };
+
+template <class... Ts>
+struct container_category<boost::container::map<Ts...>> { using type = map_container_tag; };
+
+template <class... Ts>
+struct container_category<boost::container::multimap<Ts...>> { using type = map_container_tag; };
+
+template <class... Ts>
+struct container_category<boost::container::flat_map<Ts...>> { using type = map_container_tag; };
+
+template <class... Ts>
+struct container_category<boost::container::flat_multimap<Ts...>> { using type = map_container_tag; };
+
+#if BOOST_VERSION >= 108200
+
+template <class... Ts>
+struct container_category<boost::unordered::unordered_flat_set<Ts...>> { using type = set_container_tag; };
+
+template <class... Ts>
+struct container_category<boost::unordered::unordered_node_set<Ts...>> { using type = set_container_tag; };
+
+template <class... Ts>
+struct container_category<boost::unordered::unordered_flat_map<Ts...>> { using type = map_container_tag; };
+
+template <class... Ts>
+struct container_category<boost::unordered::unordered_node_map<Ts...>> { using type = map_container_tag; };
+
+#endif // BOOST_VERSION >= 108200
+
+} // boost::redis::adapter
+
+#endif // BOOST_REDIS_ADAPTER_BOOST_CONTAINERS_HPP
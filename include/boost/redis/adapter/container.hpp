@@ -0,0 +1,100 @@
+/* Copyright (c) 2018-2024 Marcelo Zimbres Silva (mzimbres@gmail.com)
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See
+ * accompanying file LICENSE.txt)
+ */
+
+#ifndef BOOST_REDIS_ADAPTER_CONTAINER_HPP
+#define BOOST_REDIS_ADAPTER_CONTAINER_HPP
+
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace boost::redis::adapter
+{
+
+/** @brief Containers whose elements are appended with `push_back`.
+ *  @ingroup high-level-api
+ *
+ *  The container must provide `value_type`, `size`, `max_size`,
+ *  `push_back` and `back`.
+ */
+struct sequence_container_tag {};
+
+/** @brief Containers of unique or repeated keys e.g. `std::set`.
+ *  @ingroup high-level-api
+ *
+ *  The container must provide `key_type`, `iterator`, `size` and
+ *  `insert(hint, key)`. Containers that provide `key_compare` are
+ *  treated as sorted, their elements are sorted before they are
+ *  inserted at the end.
+ */
+struct set_container_tag {};
+
+/** @brief Containers of key value pairs e.g. `std::map`.
+ *  @ingroup high-level-api
+ *
+ *  The container must provide `key_type`, `mapped_type`, `iterator`,
+ *  `size` and `emplace_hint(hint, key, value)`. Containers that
+ *  provide `key_compare` are treated as sorted, see
+ *  `set_container_tag`. Repeated keys keep the last value if the
+ *  container provides `insert_or_assign`.
+ */
+struct map_container_tag {};
+
+/** @brief Customization point that allows containers to be used as responses.
+ *  @ingroup high-level-api
+ *
+ *  Specializations define `type` as one of `sequence_container_tag`,
+ *  `set_container_tag` or `map_container_tag`, for example
+ *
+ *  @code
+ *  template <class T>
+ *  struct boost::redis::adapter::container_category<my::ring<T>> {
+ *     using type = boost::redis::adapter::sequence_container_tag;
+ *  };
+ *  @endcode
+ *
+ *  The standard containers are already specialized, the Boost
+ *  containers e.g. `boost::container::flat_map` and
+ *  `boost::unordered_flat_map` are specialized in
+ *  `boost/redis/adapter/boost_containers.hpp`. Containers are
+ *  reserved before their elements are inserted, see
+ *  `boost_redis_reserve`.
+ */
+template <class T>
+struct container_category {};
+
+template <class T, class Allocator>
+struct container_category<std::vector<T, Allocator>> { using type = sequence_container_tag; };
+
+template <class Key, class Compare, class Allocator>
+struct container_category<std::set<Key, Compare, Allocator>> { using type = set_container_tag; };
+
+template <class Key, class Compare, class Allocator>
+struct container_category<std::multiset<Key, Compare, Allocator>> { using type = set_container_tag; };
+
+template <class Key, class Hash, class KeyEqual, class Allocator>
+struct container_category<std::unordered_set<Key, Hash, KeyEqual, Allocator>> { using type = set_container_tag; };
+
+template <class Key, class Hash, class KeyEqual, class Allocator>
+struct container_category<std::unordered_multiset<Key, Hash, KeyEqual, Allocator>> { using type = set_container_tag; };
+
+template <class Key, class T, class Compare, class Allocator>
+struct container_category<std::map<Key, T, Compare, Allocator>> { using type = map_container_tag; };
+
+template <class Key, class T, class Compare, class Allocator>
+struct container_category<std::multimap<Key, T, Compare, Allocator>> { using type = map_container_tag; };
+
+template <class Key, class T, class Hash, class KeyEqual, class Allocator>
+struct container_category<std::unordered_map<Key, T, Hash, KeyEqual, Allocator>> { using type = map_container_tag; };
+
+template <class Key, class T, class Hash, class KeyEqual, class Allocator>
+struct container_category<std::unordered_multimap<Key, T, Hash, KeyEqual, Allocator>> { using type = map_container_tag; };
+
+} // boost::redis::adapter
+
+#endif // BOOST_REDIS_ADAPTER_CONTAINER_HPP
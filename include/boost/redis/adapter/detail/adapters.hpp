@@ -8,10 +8,13 @@
 #define BOOST_REDIS_ADAPTER_ADAPTERS_HPP
 
 #include <boost/redis/error.hpp>
+#include <boost/redis/bulk_sink.hpp>
+#include <boost/redis/string_views.hpp>
 #include <boost/redis/resp3/type.hpp>
 #include <boost/redis/resp3/serialization.hpp>
 #include <boost/redis/resp3/node.hpp>
 #include <boost/redis/adapter/result.hpp>
+#include <boost/redis/adapter/container.hpp>
 #include <boost/assert.hpp>
 
 #include <set>
@@ -25,8 +28,14 @@
 #include <deque>
 #include <vector>
 #include <array>
+#include <string>
 #include <string_view>
+#include <memory>
 #include <charconv>
+#include <type_traits>
+#include <algorithm>
+#include <iterator>
+#include <utility>
 
 // See https://stackoverflow.com/a/31658120/1077832
 #include<ciso646>
@@ -83,6 +92,94 @@ boost_redis_from_bulk(
   s.append(sv.data(), sv.size());
 }
 
+// Capacity.
+
+template <class T, class = void>
+struct has_reserve : std::false_type {};
+
+template <class T>
+struct has_reserve<T, std::void_t<decltype(std::declval<T&>().reserve(std::size_t{}))>>
+   : std::true_type {};
+
+// Called with the number of elements the container is about to hold,
+// before they are inserted. Found by ADL, so that it can be
+// overloaded for user containers.
+template <class Container>
+void boost_redis_reserve(Container& c, std::size_t n)
+{
+   if constexpr (has_reserve<Container>::value)
+      c.reserve(n);
+}
+
+template <class T, class = void>
+struct has_allocator : std::false_type {};
+
+template <class T>
+struct has_allocator<T, std::void_t<typename T::allocator_type>> : std::true_type {};
+
+template <class T, class Container, class = void>
+struct uses_container_allocator : std::false_type {};
+
+template <class T, class Container>
+struct uses_container_allocator<T, Container, std::enable_if_t<has_allocator<Container>::value>>
+   : std::bool_constant<
+        std::uses_allocator<T, typename Container::allocator_type>::value &&
+        std::is_constructible<T, typename Container::allocator_type const&>::value> {};
+
+// Elements are constructed with the allocator of the container when
+// they support it e.g. std::pmr::string in a std::pmr::map, so that
+// they are moved into it rather than copied, and their memory comes
+// from the same place as the container's.
+template <class T, class Container>
+auto make_element(Container const& c) -> T
+{
+   if constexpr (uses_container_allocator<T, Container>::value)
+      return T(c.get_allocator());
+   else
+      return T{};
+}
+
+// Sorted containers e.g. std::set and std::map.
+template <class T, class = void>
+struct is_sorted_container : std::false_type {};
+
+template <class T>
+struct is_sorted_container<T, std::void_t<typename T::key_compare>>
+   : std::true_type {};
+
+template <class T, class = void>
+struct has_insert_or_assign : std::false_type {};
+
+template <class T>
+struct has_insert_or_assign<T, std::void_t<decltype(std::declval<T&>().insert_or_assign(std::declval<typename T::key_type>(), std::declval<typename T::mapped_type>()))>>
+   : std::true_type {};
+
+// Counts the leaf elements of the aggregate being read, so that
+// adapters that collect them know when the last one arrived. Nested
+// aggregates count as their elements.
+class element_counter {
+private:
+   std::size_t remaining_ = 0;
+
+public:
+   void on_aggregate(std::size_t n) noexcept
+   {
+      if (remaining_ != 0)
+         --remaining_;
+
+      remaining_ += n;
+   }
+
+   void on_element() noexcept
+   {
+      BOOST_ASSERT(remaining_ != 0);
+      --remaining_;
+   }
+
+   [[nodiscard]] auto done() const noexcept
+      { return remaining_ == 0; }
+};
+
 //================================================
 
 template <class Result>
@@ -107,6 +204,48 @@ public:
    }
 };
 
+template <class Result>
+class flat_aggregate {
+private:
+   Result* result_;
+
+public:
+   explicit flat_aggregate(Result* c = nullptr): result_(c) {}
+   template <class String>
+   void operator()(resp3::basic_node<String> const& nd, system::error_code&)
+   {
+      BOOST_ASSERT_MSG(!!result_, "Unexpected null pointer");
+      switch (nd.data_type) {
+         case resp3::type::blob_error:
+         case resp3::type::simple_error:
+            *result_ = error{nd.data_type, std::string{std::cbegin(nd.value), std::cend(nd.value)}};
+            break;
+         default:
+            result_->value().push_back(nd);
+      }
+   }
+};
+
+// Records the bytes of each message instead of its nodes, see
+// resp3::parse. Error replies are recorded as any other reply.
+template <class Result>
+class raw_messages {
+private:
+   Result* result_;
+
+public:
+   explicit raw_messages(Result* c = nullptr): result_(c) {}
+
+   template <class String>
+   void operator()(resp3::basic_node<String> const&, system::error_code&) { }
+
+   void on_raw(std::string_view msg)
+   {
+      BOOST_ASSERT_MSG(!!result_, "Unexpected null pointer");
+      result_->value().push_back(msg);
+   }
+};
+
 template <class Node>
 class general_simple {
 private:
@@ -133,6 +272,52 @@ public:
    }
 };
 
+// Passes bulk strings to a bulk_sink, large ones arrive as streamed
+// strings, see resp3::parser::set_bulk_chunk_size.
+template <class Result>
+class bulk_chunks {
+private:
+   Result* result_;
+
+public:
+   explicit bulk_chunks(Result* r = nullptr) : result_(r) {}
+
+   template <class String>
+   void operator()(resp3::basic_node<String> const& nd, system::error_code& ec)
+   {
+      BOOST_ASSERT_MSG(!!result_, "Unexpected null pointer");
+
+      if (result_->has_error())
+         return;
+
+      switch (nd.data_type) {
+         case resp3::type::null:
+         case resp3::type::blob_error:
+         case resp3::type::simple_error:
+            *result_ = error{nd.data_type, std::string{std::cbegin(nd.value), std::cend(nd.value)}};
+            break;
+         case resp3::type::streamed_string:
+            result_->value().clear();
+            break;
+         case resp3::type::streamed_string_part:
+            result_->value().on_chunk(nd.value, ec);
+            break;
+         default:
+         {
+            if (is_aggregate(nd.data_type)) {
+               ec = redis::error::expects_resp3_simple_type;
+               return;
+            }
+
+            result_->value().clear();
+            result_->value().on_chunk(nd.value, ec);
+            if (!ec && !std::empty(nd.value))
+               result_->value().on_chunk({}, ec);
+         }
+      }
+   }
+};
+
 template <class Result>
 class simple_impl {
 public:
@@ -150,10 +335,34 @@ public:
    }
 };
 
+// Unordered containers are reserved from the aggregate size. The
+// elements of sorted containers are collected and inserted in order
+// once the last one arrived, so that each insertion takes constant
+// time.
 template <class Result>
 class set_impl {
 private:
+   static constexpr bool is_sorted = is_sorted_container<Result>::value;
+
    typename Result::iterator hint_;
+   std::vector<typename Result::key_type> pending_;
+   element_counter counter_;
+
+   void insert_pending(Result& result)
+   {
+      std::stable_sort(std::begin(pending_), std::end(pending_), result.key_comp());
+      for (auto& obj: pending_)
+         result.insert(std::end(result), std::move(obj));
+
+      pending_ = {};
+   }
+
+   // Elements left from a message that failed to parse.
+   void reset()
+   {
+      pending_.clear();
+      counter_ = {};
+   }
 
 public:
    void on_value_available(Result& result)
@@ -163,8 +372,26 @@ public:
    void operator()(Result& result, resp3::basic_node<String> const& nd, system::error_code& ec)
    {
       if (is_aggregate(nd.data_type)) {
-         if (nd.data_type != resp3::type::set)
+         if (nd.data_type != resp3::type::set) {
             ec = redis::error::expects_resp3_set;
+            return;
+         }
+
+         if constexpr (is_sorted) {
+            if (nd.depth == 0)
+               reset();
+
+            auto const n = std::size(pending_) + nd.aggregate_size;
+            pending_.reserve(n);
+            boost_redis_reserve(result, std::size(result) + n);
+            counter_.on_aggregate(nd.aggregate_size);
+            if (counter_.done())
+               insert_pending(result);
+         } else {
+            // Reserving might rehash, which invalidates the hint.
+            boost_redis_reserve(result, std::size(result) + nd.aggregate_size);
+            hint_ = std::end(result);
+         }
          return;
       }
 
@@ -175,18 +402,59 @@ public:
 	 return;
       }
 
-      typename Result::key_type obj;
+      auto obj = make_element<typename Result::key_type>(result);
       boost_redis_from_bulk(obj, nd.value, ec);
-      hint_ = result.insert(hint_, std::move(obj));
+
+      if constexpr (is_sorted) {
+         pending_.push_back(std::move(obj));
+         counter_.on_element();
+         if (counter_.done())
+            insert_pending(result);
+      } else {
+         hint_ = result.insert(hint_, std::move(obj));
+      }
    }
 };
 
+// See set_impl. Keys that appear more than once keep the last value,
+// except in containers of non-unique keys.
 template <class Result>
 class map_impl {
 private:
+   static constexpr bool is_sorted = is_sorted_container<Result>::value;
+
+   using key_type = typename Result::key_type;
+   using mapped_type = typename Result::mapped_type;
+
    typename Result::iterator current_;
+   std::vector<std::pair<key_type, mapped_type>> pending_;
+   element_counter counter_;
    bool on_key_ = true;
 
+   void insert_pending(Result& result)
+   {
+      auto const comp = [&result](auto const& a, auto const& b)
+         { return result.key_comp()(a.first, b.first); };
+
+      std::stable_sort(std::begin(pending_), std::end(pending_), comp);
+      for (auto& [key, value]: pending_) {
+         if constexpr (has_insert_or_assign<Result>::value)
+            result.insert_or_assign(std::end(result), std::move(key), std::move(value));
+         else
+            result.emplace_hint(std::end(result), std::move(key), std::move(value));
+      }
+
+      pending_ = {};
+   }
+
+   // Elements left from a message that failed to parse.
+   void reset()
+   {
+      pending_.clear();
+      counter_ = {};
+      on_key_ = true;
+   }
+
 public:
    void on_value_available(Result& result)
       { current_ = std::end(result); }
@@ -195,8 +463,26 @@ public:
    void operator()(Result& result, resp3::basic_node<String> const& nd, system::error_code& ec)
    {
       if (is_aggregate(nd.data_type)) {
-         if (element_multiplicity(nd.data_type) != 2)
+         if (element_multiplicity(nd.data_type) != 2) {
            ec = redis::error::expects_resp3_map;
+           return;
+         }
+
+         if constexpr (is_sorted) {
+            if (nd.depth == 0)
+               reset();
+
+            auto const n = std::size(pending_) + nd.aggregate_size;
+            pending_.reserve(n);
+            boost_redis_reserve(result, std::size(result) + n);
+            counter_.on_aggregate(2 * nd.aggregate_size);
+            if (counter_.done())
+               insert_pending(result);
+         } else if (on_key_) {
+            // Reserving might rehash, which invalidates the hint.
+            boost_redis_reserve(result, std::size(result) + nd.aggregate_size);
+            current_ = std::end(result);
+         }
          return;
       }
 
@@ -207,12 +493,23 @@ public:
 	 return;
       }
 
-      if (on_key_) {
-         typename Result::key_type obj;
+      if constexpr (is_sorted) {
+         if (on_key_) {
+            pending_.emplace_back(make_element<key_type>(result), make_element<mapped_type>(result));
+            boost_redis_from_bulk(pending_.back().first, nd.value, ec);
+         } else {
+            boost_redis_from_bulk(pending_.back().second, nd.value, ec);
+         }
+
+         counter_.on_element();
+         if (counter_.done())
+            insert_pending(result);
+      } else if (on_key_) {
+         auto obj = make_element<key_type>(result);
          boost_redis_from_bulk(obj, nd.value, ec);
-         current_ = result.insert(current_, {std::move(obj), {}});
+         current_ = result.emplace_hint(current_, std::move(obj), make_element<mapped_type>(result));
       } else {
-         typename Result::mapped_type obj;
+         auto obj = make_element<mapped_type>(result);
          boost_redis_from_bulk(obj, nd.value, ec);
          current_->second = std::move(obj);
       }
@@ -230,8 +527,15 @@ public:
    void operator()(Result& result, resp3::basic_node<String> const& nd, system::error_code& ec)
    {
       if (is_aggregate(nd.data_type)) {
-         auto const m = element_multiplicity(nd.data_type);
-         result.reserve(result.size() + m * nd.aggregate_size);
+         auto const n = std::size(result) + element_multiplicity(nd.data_type) * nd.aggregate_size;
+
+         // Fixed capacity containers e.g. static_vector.
+         if (n > result.max_size()) {
+            ec = redis::error::incompatible_size;
+            return;
+         }
+
+         boost_redis_reserve(result, n);
       } else {
          result.push_back({});
          boost_redis_from_bulk(result.back(), nd.value, ec);
@@ -282,7 +586,10 @@ struct list_impl {
    template <class String>
    void operator()(Result& result, resp3::basic_node<String> const& nd, system::error_code& ec)
    {
-      if (!is_aggregate(nd.data_type)) {
+      if (is_aggregate(nd.data_type)) {
+         auto const m = element_multiplicity(nd.data_type);
+         boost_redis_reserve(result, std::size(result) + m * nd.aggregate_size);
+      } else {
         BOOST_ASSERT(nd.aggregate_size == 1);
         if (nd.depth < 1) {
            ec = redis::error::expects_resp3_aggregate;
@@ -295,41 +602,99 @@ struct list_impl {
    }
 };
 
-//---------------------------------------------------
+// Copies values into the arena of a string_views and adds views of
+// the copies to its container, see container_category.
+template <class Result>
+class views_impl {
+private:
+   using container_type = typename Result::container_type;
+   using category = typename container_category<container_type>::type;
 
-template <class T>
-struct impl_map { using type = simple_impl<T>; };
+   std::string_view key_;
+   bool on_key_ = true;
 
-template <class Key, class Compare, class Allocator>
-struct impl_map<std::set<Key, Compare, Allocator>> { using type = set_impl<std::set<Key, Compare, Allocator>>; };
+public:
+   void on_value_available(Result&) { }
 
-template <class Key, class Compare, class Allocator>
-struct impl_map<std::multiset<Key, Compare, Allocator>> { using type = set_impl<std::multiset<Key, Compare, Allocator>>; };
+   template <class String>
+   void operator()(Result& result, resp3::basic_node<String> const& nd, system::error_code& ec)
+   {
+      auto& values = result.get();
 
-template <class Key, class Hash, class KeyEqual, class Allocator>
-struct impl_map<std::unordered_set<Key, Hash, KeyEqual, Allocator>> { using type = set_impl<std::unordered_set<Key, Hash, KeyEqual, Allocator>>; };
+      if (is_aggregate(nd.data_type)) {
+         auto const m = element_multiplicity(nd.data_type);
+
+         if constexpr (std::is_same<category, map_container_tag>::value) {
+            if (m != 2) {
+               ec = redis::error::expects_resp3_map;
+               return;
+            }
+
+            boost_redis_reserve(values, std::size(values) + nd.aggregate_size);
+         } else if constexpr (std::is_same<category, set_container_tag>::value) {
+            if (nd.data_type != resp3::type::set) {
+               ec = redis::error::expects_resp3_set;
+               return;
+            }
+
+            boost_redis_reserve(values, std::size(values) + nd.aggregate_size);
+         } else {
+            boost_redis_reserve(values, std::size(values) + m * nd.aggregate_size);
+         }
+         return;
+      }
 
-template <class Key, class Hash, class KeyEqual, class Allocator>
-struct impl_map<std::unordered_multiset<Key, Hash, KeyEqual, Allocator>> { using type = set_impl<std::unordered_multiset<Key, Hash, KeyEqual, Allocator>>; };
+      if (nd.depth < 1) {
+         ec = redis::error::expects_resp3_aggregate;
+         return;
+      }
 
-template <class Key, class T, class Compare, class Allocator>
-struct impl_map<std::map<Key, T, Compare, Allocator>> { using type = map_impl<std::map<Key, T, Compare, Allocator>>; };
+      auto const v = result.store(std::string_view{nd.value});
 
-template <class Key, class T, class Compare, class Allocator>
-struct impl_map<std::multimap<Key, T, Compare, Allocator>> { using type = map_impl<std::multimap<Key, T, Compare, Allocator>>; };
+      if constexpr (std::is_same<category, map_container_tag>::value) {
+         if (on_key_) {
+            key_ = v;
+         } else if constexpr (has_insert_or_assign<container_type>::value) {
+            values.insert_or_assign(key_, v);
+         } else {
+            values.emplace(key_, v);
+         }
 
-template <class Key, class Hash, class KeyEqual, class Allocator>
-struct impl_map<std::unordered_map<Key, Hash, KeyEqual, Allocator>> { using type = map_impl<std::unordered_map<Key, Hash, KeyEqual, Allocator>>; };
+         on_key_ = !on_key_;
+      } else if constexpr (std::is_same<category, set_container_tag>::value) {
+         values.insert(v);
+      } else {
+         values.push_back(v);
+      }
+   }
+};
 
-template <class Key, class Hash, class KeyEqual, class Allocator>
-struct impl_map<std::unordered_multimap<Key, Hash, KeyEqual, Allocator>> { using type = map_impl<std::unordered_multimap<Key, Hash, KeyEqual, Allocator>>; };
+//---------------------------------------------------
 
-template <class T, class Allocator>
-struct impl_map<std::vector<T, Allocator>> { using type = vector_impl<std::vector<T, Allocator>>; };
+template <class Result, class Category>
+struct category_impl;
+
+template <class Result>
+struct category_impl<Result, sequence_container_tag> { using type = vector_impl<Result>; };
+
+template <class Result>
+struct category_impl<Result, set_container_tag> { using type = set_impl<Result>; };
+
+template <class Result>
+struct category_impl<Result, map_container_tag> { using type = map_impl<Result>; };
+
+template <class T, class = void>
+struct impl_map { using type = simple_impl<T>; };
+
+template <class T>
+struct impl_map<T, std::void_t<typename container_category<T>::type>> { using type = typename category_impl<T, typename container_category<T>::type>::type; };
 
 template <class T, std::size_t N>
 struct impl_map<std::array<T, N>> { using type = array_impl<std::array<T, N>>; };
 
+template <class Container>
+struct impl_map<string_views<Container>> { using type = views_impl<string_views<Container>>; };
+
 template <class T, class Allocator>
 struct impl_map<std::list<T, Allocator>> { using type = list_impl<std::list<T, Allocator>>; };
 
@@ -338,6 +703,12 @@ struct impl_map<std::deque<T, Allocator>> { using type = list_impl<std::deque<T,
 
 //---------------------------------------------------
 
+template <class>
+struct is_char_string : std::false_type {};
+
+template <class Traits, class Allocator>
+struct is_char_string<std::basic_string<char, Traits, Allocator>> : std::true_type {};
+
 template <class>
 class wrapper;
 
@@ -372,6 +743,25 @@ public:
       }
    }
 
+   // Returns where a bulk string of n bytes can be written to, as if
+   // it had been passed to operator(), or nullptr.
+   auto bulk_destination(std::size_t n) -> char*
+   {
+      BOOST_ASSERT_MSG(!!result_, "Unexpected null pointer");
+
+      if constexpr (is_char_string<Result>::value) {
+         if (result_->has_error())
+            return nullptr;
+
+         auto& s = result_->value();
+         auto const size = s.size();
+         s.resize(size + n);
+         return s.data() + size;
+      } else {
+         return nullptr;
+      }
+   }
+
    template <class String>
    void operator()(resp3::basic_node<String> const& nd, system::error_code& ec)
    {
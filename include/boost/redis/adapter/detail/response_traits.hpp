@@ -13,8 +13,10 @@
 #include <boost/mp11.hpp>
 #include <boost/system.hpp>
 
+#include <array>
 #include <tuple>
 #include <limits>
+#include <utility>
 #include <string_view>
 #include <variant>
 
@@ -39,6 +41,13 @@ public:
       { return static_cast<std::size_t>(-1);}
 };
 
+template <class Adapter, class = void>
+struct has_bulk_destination : std::false_type {};
+
+template <class Adapter>
+struct has_bulk_destination<Adapter, std::void_t<decltype(std::declval<Adapter&>().bulk_destination(std::size_t{}))>>
+   : std::true_type {};
+
 template <class Response>
 class static_adapter {
 private:
@@ -49,6 +58,14 @@ private:
 
    adapters_array_type adapters_;
 
+   template <std::size_t... Is>
+   static constexpr auto make_chunked(std::index_sequence<Is...>) noexcept
+   {
+      return std::array<bool, size>{accepts_bulk_chunks<std::tuple_element_t<Is, Response>>::value...};
+   }
+
+   static constexpr std::array<bool, size> chunked_ = make_chunked(std::make_index_sequence<size>{});
+
 public:
    explicit static_adapter(Response& r)
    {
@@ -59,6 +76,24 @@ public:
    auto get_supported_response_size() const noexcept
       { return size;}
 
+   // Whether the i-th response accepts bulk strings in chunks.
+   [[nodiscard]]
+   auto supports_bulk_chunks(std::size_t i) const noexcept
+      { return i < size && chunked_[i]; }
+
+   // Returns where a bulk string of n bytes that is the i-th
+   // response can be read into, or nullptr.
+   auto bulk_destination(std::size_t i, std::size_t n) -> char*
+   {
+      BOOST_ASSERT(i < adapters_.size());
+      return std::visit([n](auto& arg) -> char* {
+         if constexpr (has_bulk_destination<std::decay_t<decltype(arg)>>::value)
+            return arg.bulk_destination(n);
+         else
+            return nullptr;
+      }, adapters_[i]);
+   }
+
    template <class String>
    void operator()(std::size_t i, resp3::basic_node<String> const& nd, system::error_code& ec)
    {
@@ -67,6 +102,16 @@ public:
       BOOST_ASSERT(i < adapters_.size());
       visit([&](auto& arg){arg(nd, ec);}, adapters_.at(i));
    }
+
+   // Calls f with the adapter of the i-th response, so that all
+   // nodes of that response can be passed to it after a single
+   // dispatch.
+   template <class F>
+   auto visit_adapter(std::size_t i, F&& f)
+   {
+      BOOST_ASSERT(i < adapters_.size());
+      return std::visit(std::forward<F>(f), adapters_[i]);
+   }
 };
 
 template <class Vector>
@@ -90,6 +135,10 @@ public:
    {
       adapter_(nd, ec);
    }
+
+   template <class F>
+   auto visit_adapter(std::size_t, F&& f)
+      { return std::forward<F>(f)(adapter_); }
 };
 
 template <class>
@@ -122,6 +171,33 @@ struct response_traits<result<std::vector<resp3::basic_node<String>, Allocator>>
       { return adapter_type{v}; }
 };
 
+template <>
+struct response_traits<result<resp3::flat_tape>> {
+   using response_type = result<resp3::flat_tape>;
+   using adapter_type = vector_adapter<response_type>;
+
+   static auto adapt(response_type& v) noexcept
+      { return adapter_type{v}; }
+};
+
+template <>
+struct response_traits<result<resp3::node_queue>> {
+   using response_type = result<resp3::node_queue>;
+   using adapter_type = vector_adapter<response_type>;
+
+   static auto adapt(response_type& v) noexcept
+      { return adapter_type{v}; }
+};
+
+template <>
+struct response_traits<result<resp3::raw_tape>> {
+   using response_type = result<resp3::raw_tape>;
+   using adapter_type = vector_adapter<response_type>;
+
+   static auto adapt(response_type& v) noexcept
+      { return adapter_type{v}; }
+};
+
 template <class ...Ts>
 struct response_traits<response<Ts...>> {
    using response_type = response<Ts...>;
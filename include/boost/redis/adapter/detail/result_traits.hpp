@@ -13,6 +13,9 @@
 #include <boost/redis/adapter/detail/adapters.hpp>
 #include <boost/redis/adapter/result.hpp>
 #include <boost/redis/adapter/ignore.hpp>
+#include <boost/redis/resp3/flat_tape.hpp>
+#include <boost/redis/resp3/node_queue.hpp>
+#include <boost/redis/resp3/raw_tape.hpp>
 #include <boost/mp11.hpp>
 
 #include <vector>
@@ -62,6 +65,46 @@ struct result_traits<result<std::vector<resp3::basic_node<String>, Allocator>>>
    static auto adapt(response_type& v) noexcept { return adapter_type{&v}; }
 };
 
+template <>
+struct result_traits<result<resp3::flat_tape>> {
+   using response_type = result<resp3::flat_tape>;
+   using adapter_type = adapter::detail::flat_aggregate<response_type>;
+   static auto adapt(response_type& v) noexcept { return adapter_type{&v}; }
+};
+
+template <>
+struct result_traits<result<resp3::node_queue>> {
+   using response_type = result<resp3::node_queue>;
+   using adapter_type = adapter::detail::flat_aggregate<response_type>;
+   static auto adapt(response_type& v) noexcept { return adapter_type{&v}; }
+};
+
+template <>
+struct result_traits<result<resp3::raw_tape>> {
+   using response_type = result<resp3::raw_tape>;
+   using adapter_type = adapter::detail::raw_messages<response_type>;
+   static auto adapt(response_type& v) noexcept { return adapter_type{&v}; }
+};
+
+template <>
+struct result_traits<result<bulk_sink>> {
+   using response_type = result<bulk_sink>;
+   using adapter_type = adapter::detail::bulk_chunks<response_type>;
+   static auto adapt(response_type& v) noexcept { return adapter_type{&v}; }
+};
+
+// Whether large bulk strings can be passed to the adapter of T in
+// chunks.
+template <class T>
+struct accepts_bulk_chunks : std::false_type {};
+
+template <>
+struct accepts_bulk_chunks<result<bulk_sink>> : std::true_type {};
+
+// Strings append the parts of streamed strings.
+template <class Traits, class Allocator>
+struct accepts_bulk_chunks<result<std::basic_string<char, Traits, Allocator>>> : std::true_type {};
+
 template <class T>
 using adapter_t = typename result_traits<std::decay_t<T>>::adapter_type;
 
@@ -0,0 +1,84 @@
+/* Copyright (c) 2018-2024 Marcelo Zimbres Silva (mzimbres@gmail.com)
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See
+ * accompanying file LICENSE.txt)
+ */
+
+#ifndef BOOST_REDIS_BULK_SINK_HPP
+#define BOOST_REDIS_BULK_SINK_HPP
+
+#include <boost/system/error_code.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <string_view>
+#include <utility>
+
+namespace boost::redis
+{
+
+/** @brief Receives a bulk string in chunks as it is read.
+ *  @ingroup high-level-api
+ *
+ *  Bulk strings larger than `config::bulk_chunk_size` are passed to
+ *  the function in chunks of the data read from the socket, which is
+ *  discarded right after, so that the value never has to be held in
+ *  memory as a whole. The function is called with the offset of the
+ *  chunk in the value and the chunk itself, the last call has an
+ *  empty chunk. For example
+ *
+ *  @code
+ *  std::ofstream out{"model.bin", std::ios::binary};
+ *
+ *  response<bulk_sink> resp{bulk_sink{
+ *     [&](std::size_t, std::string_view chunk, system::error_code&) {
+ *        out.write(chunk.data(), chunk.size());
+ *     }}};
+ *
+ *  request req;
+ *  req.push("GET", "model");
+ *  co_await conn.async_exec(req, resp);
+ *  @endcode
+ *
+ *  Smaller values, and streamed strings sent by the server, are
+ *  passed in the same way. Setting an error code aborts the
+ *  operation.
+ */
+class bulk_sink {
+public:
+   /// The function type.
+   using function_type = std::function<void(std::size_t offset, std::string_view chunk, system::error_code& ec)>;
+
+   /// Default constructor, discards the data.
+   bulk_sink() = default;
+
+   /// Constructor
+   explicit bulk_sink(function_type f)
+   : f_{std::move(f)}
+   { }
+
+   /// Number of bytes received so far.
+   [[nodiscard]] auto size() const noexcept
+      { return size_; }
+
+   /// Passes a chunk to the function, an empty chunk ends the value.
+   void on_chunk(std::string_view chunk, system::error_code& ec)
+   {
+      if (f_)
+         f_(size_, chunk, ec);
+
+      size_ += std::size(chunk);
+   }
+
+   /// Prepares for a new value.
+   void clear() noexcept
+      { size_ = 0; }
+
+private:
+   function_type f_;
+   std::size_t size_ = 0;
+};
+
+} // boost::redis
+
+#endif // BOOST_REDIS_BULK_SINK_HPP
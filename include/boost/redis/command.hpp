@@ -0,0 +1,240 @@
+/* Copyright (c) 2018-2024 Marcelo Zimbres Silva (mzimbres@gmail.com)
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See
+ * accompanying file LICENSE.txt)
+ */
+
+#ifndef BOOST_REDIS_COMMAND_HPP
+#define BOOST_REDIS_COMMAND_HPP
+
+#include <cstddef>
+#include <string_view>
+
+namespace boost::redis {
+
+/** @brief Properties of a Redis command.
+ *  @ingroup high-level-api
+ *
+ *  Objects of this type are known at compile time, see the catalog
+ *  in the `boost::redis::cmd` namespace, and can be passed to
+ *  `request::push` in place of the command name. The key positions
+ *  follow the conventions of the Redis
+ *  [COMMAND](https://redis.io/commands/command/) command.
+ */
+struct command {
+   /// Flags.
+   enum flag : unsigned {
+      /// The command does not modify data.
+      readonly = 1,
+      /// The command may modify data.
+      write = 2,
+      /// The command may block the connection.
+      blocking = 4,
+      /// The command is part of the connection handshake i.e. `HELLO`.
+      handshake = 8,
+   };
+
+   /// Command name.
+   std::string_view name;
+
+   /** @brief Number of responses delivered to `async_exec`.
+    *
+    *  Zero for commands whose responses are received as server
+    *  pushes e.g. `SUBSCRIBE`.
+    */
+   std::size_t responses = 1;
+
+   /// Position of the first key in the arguments starting at one, zero if there are no keys at fixed positions.
+   int first_key = 0;
+
+   /// Position of the last key, negative values count from the last argument e.g. -1 is the last argument.
+   int last_key = 0;
+
+   /// Step between keys e.g. 2 for key value pairs.
+   int key_step = 0;
+
+   /// A combination of the values in `flag`.
+   unsigned flags = 0;
+
+   /// Returns true if the command has keys at fixed positions.
+   [[nodiscard]] constexpr auto has_keys() const noexcept
+      { return first_key != 0; }
+
+   /// Returns true if the command does not modify data.
+   [[nodiscard]] constexpr auto is_readonly() const noexcept
+      { return (flags & readonly) != 0; }
+
+   /// Returns true if the command may modify data.
+   [[nodiscard]] constexpr auto is_write() const noexcept
+      { return (flags & write) != 0; }
+
+   /// Returns true if the command may block the connection.
+   [[nodiscard]] constexpr auto is_blocking() const noexcept
+      { return (flags & blocking) != 0; }
+
+   /// Returns true for `HELLO`.
+   [[nodiscard]] constexpr auto is_handshake() const noexcept
+      { return (flags & handshake) != 0; }
+};
+
+/** @brief Catalog of Redis commands.
+ *  @ingroup high-level-api
+ *
+ *  For example
+ *
+ *  @code
+ *  request req;
+ *  req.push(cmd::set, "key", "value", "EX", 10);
+ *  req.push(cmd::get, "key");
+ *  @endcode
+ */
+namespace cmd {
+
+// Connection.
+inline constexpr command hello{"HELLO", 1, 0, 0, 0, command::handshake};
+inline constexpr command auth{"AUTH", 1, 0, 0, 0, 0};
+inline constexpr command ping{"PING", 1, 0, 0, 0, 0};
+inline constexpr command echo{"ECHO", 1, 0, 0, 0, 0};
+inline constexpr command select{"SELECT", 1, 0, 0, 0, 0};
+inline constexpr command client{"CLIENT", 1, 0, 0, 0, 0};
+inline constexpr command quit{"QUIT", 1, 0, 0, 0, 0};
+
+// Server.
+inline constexpr command info{"INFO", 1, 0, 0, 0, 0};
+inline constexpr command dbsize{"DBSIZE", 1, 0, 0, 0, command::readonly};
+inline constexpr command flushall{"FLUSHALL", 1, 0, 0, 0, command::write};
+inline constexpr command flushdb{"FLUSHDB", 1, 0, 0, 0, command::write};
+
+// Keys.
+inline constexpr command del{"DEL", 1, 1, -1, 1, command::write};
+inline constexpr command unlink{"UNLINK", 1, 1, -1, 1, command::write};
+inline constexpr command exists{"EXISTS", 1, 1, -1, 1, command::readonly};
+inline constexpr command expire{"EXPIRE", 1, 1, 1, 1, command::write};
+inline constexpr command pexpire{"PEXPIRE", 1, 1, 1, 1, command::write};
+inline constexpr command persist{"PERSIST", 1, 1, 1, 1, command::write};
+inline constexpr command ttl{"TTL", 1, 1, 1, 1, command::readonly};
+inline constexpr command pttl{"PTTL", 1, 1, 1, 1, command::readonly};
+inline constexpr command type{"TYPE", 1, 1, 1, 1, command::readonly};
+inline constexpr command rename{"RENAME", 1, 1, 2, 1, command::write};
+inline constexpr command scan{"SCAN", 1, 0, 0, 0, command::readonly};
+
+// Strings.
+inline constexpr command get{"GET", 1, 1, 1, 1, command::readonly};
+inline constexpr command set{"SET", 1, 1, 1, 1, command::write};
+inline constexpr command getdel{"GETDEL", 1, 1, 1, 1, command::write};
+inline constexpr command getex{"GETEX", 1, 1, 1, 1, command::write};
+inline constexpr command mget{"MGET", 1, 1, -1, 1, command::readonly};
+inline constexpr command mset{"MSET", 1, 1, -1, 2, command::write};
+inline constexpr command append{"APPEND", 1, 1, 1, 1, command::write};
+inline constexpr command strlen{"STRLEN", 1, 1, 1, 1, command::readonly};
+inline constexpr command incr{"INCR", 1, 1, 1, 1, command::write};
+inline constexpr command incrby{"INCRBY", 1, 1, 1, 1, command::write};
+inline constexpr command incrbyfloat{"INCRBYFLOAT", 1, 1, 1, 1, command::write};
+inline constexpr command decr{"DECR", 1, 1, 1, 1, command::write};
+inline constexpr command decrby{"DECRBY", 1, 1, 1, 1, command::write};
+
+// Hashes.
+inline constexpr command hget{"HGET", 1, 1, 1, 1, command::readonly};
+inline constexpr command hmget{"HMGET", 1, 1, 1, 1, command::readonly};
+inline constexpr command hgetall{"HGETALL", 1, 1, 1, 1, command::readonly};
+inline constexpr command hset{"HSET", 1, 1, 1, 1, command::write};
+inline constexpr command hdel{"HDEL", 1, 1, 1, 1, command::write};
+inline constexpr command hexists{"HEXISTS", 1, 1, 1, 1, command::readonly};
+inline constexpr command hincrby{"HINCRBY", 1, 1, 1, 1, command::write};
+inline constexpr command hlen{"HLEN", 1, 1, 1, 1, command::readonly};
+inline constexpr command hkeys{"HKEYS", 1, 1, 1, 1, command::readonly};
+inline constexpr command hvals{"HVALS", 1, 1, 1, 1, command::readonly};
+
+// Lists.
+inline constexpr command lpush{"LPUSH", 1, 1, 1, 1, command::write};
+inline constexpr command rpush{"RPUSH", 1, 1, 1, 1, command::write};
+inline constexpr command lpop{"LPOP", 1, 1, 1, 1, command::write};
+inline constexpr command rpop{"RPOP", 1, 1, 1, 1, command::write};
+inline constexpr command lrange{"LRANGE", 1, 1, 1, 1, command::readonly};
+inline constexpr command llen{"LLEN", 1, 1, 1, 1, command::readonly};
+inline constexpr command lindex{"LINDEX", 1, 1, 1, 1, command::readonly};
+inline constexpr command lrem{"LREM", 1, 1, 1, 1, command::write};
+inline constexpr command ltrim{"LTRIM", 1, 1, 1, 1, command::write};
+inline constexpr command lmove{"LMOVE", 1, 1, 2, 1, command::write};
+inline constexpr command blpop{"BLPOP", 1, 1, -2, 1, command::write | command::blocking};
+inline constexpr command brpop{"BRPOP", 1, 1, -2, 1, command::write | command::blocking};
+inline constexpr command blmove{"BLMOVE", 1, 1, 2, 1, command::write | command::blocking};
+
+// Sets.
+inline constexpr command sadd{"SADD", 1, 1, 1, 1, command::write};
+inline constexpr command srem{"SREM", 1, 1, 1, 1, command::write};
+inline constexpr command smembers{"SMEMBERS", 1, 1, 1, 1, command::readonly};
+inline constexpr command sismember{"SISMEMBER", 1, 1, 1, 1, command::readonly};
+inline constexpr command scard{"SCARD", 1, 1, 1, 1, command::readonly};
+inline constexpr command sinter{"SINTER", 1, 1, -1, 1, command::readonly};
+inline constexpr command sunion{"SUNION", 1, 1, -1, 1, command::readonly};
+
+// Sorted sets.
+inline constexpr command zadd{"ZADD", 1, 1, 1, 1, command::write};
+inline constexpr command zrem{"ZREM", 1, 1, 1, 1, command::write};
+inline constexpr command zincrby{"ZINCRBY", 1, 1, 1, 1, command::write};
+inline constexpr command zrange{"ZRANGE", 1, 1, 1, 1, command::readonly};
+inline constexpr command zscore{"ZSCORE", 1, 1, 1, 1, command::readonly};
+inline constexpr command zrank{"ZRANK", 1, 1, 1, 1, command::readonly};
+inline constexpr command zcard{"ZCARD", 1, 1, 1, 1, command::readonly};
+inline constexpr command bzpopmin{"BZPOPMIN", 1, 1, -2, 1, command::write | command::blocking};
+inline constexpr command bzpopmax{"BZPOPMAX", 1, 1, -2, 1, command::write | command::blocking};
+
+// Streams, the keys of XREAD follow the STREAMS option.
+inline constexpr command xadd{"XADD", 1, 1, 1, 1, command::write};
+inline constexpr command xlen{"XLEN", 1, 1, 1, 1, command::readonly};
+inline constexpr command xrange{"XRANGE", 1, 1, 1, 1, command::readonly};
+inline constexpr command xread{"XREAD", 1, 0, 0, 0, command::readonly | command::blocking};
+
+// Pub/Sub, the responses to (un)subscriptions are server pushes.
+inline constexpr command publish{"PUBLISH", 1, 0, 0, 0, 0};
+inline constexpr command spublish{"SPUBLISH", 1, 1, 1, 1, 0};
+inline constexpr command subscribe{"SUBSCRIBE", 0, 0, 0, 0, 0};
+inline constexpr command unsubscribe{"UNSUBSCRIBE", 0, 0, 0, 0, 0};
+inline constexpr command psubscribe{"PSUBSCRIBE", 0, 0, 0, 0, 0};
+inline constexpr command punsubscribe{"PUNSUBSCRIBE", 0, 0, 0, 0, 0};
+inline constexpr command ssubscribe{"SSUBSCRIBE", 0, 1, -1, 1, 0};
+inline constexpr command sunsubscribe{"SUNSUBSCRIBE", 0, 1, -1, 1, 0};
+
+// Transactions.
+inline constexpr command multi{"MULTI", 1, 0, 0, 0, 0};
+inline constexpr command exec{"EXEC", 1, 0, 0, 0, 0};
+inline constexpr command discard{"DISCARD", 1, 0, 0, 0, 0};
+inline constexpr command watch{"WATCH", 1, 1, -1, 1, 0};
+
+// Scripting, the keys follow the number of keys argument.
+inline constexpr command eval{"EVAL", 1, 0, 0, 0, 0};
+inline constexpr command evalsha{"EVALSHA", 1, 0, 0, 0, 0};
+
+} // cmd
+
+namespace detail {
+
+// Returns true for the commands whose responses are not
+// delivered to async_exec.
+constexpr auto has_response(std::string_view cmd) noexcept -> bool
+{
+   return cmd == "SUBSCRIBE"
+       || cmd == "PSUBSCRIBE"
+       || cmd == "SSUBSCRIBE"
+       || cmd == "UNSUBSCRIBE"
+       || cmd == "PUNSUBSCRIBE"
+       || cmd == "SUNSUBSCRIBE";
+}
+
+// Commands pushed by name and through the catalog must be counted
+// the same.
+constexpr auto is_consistent(command const& c) noexcept
+   { return (c.responses == 0) == has_response(c.name); }
+
+static_assert(
+   is_consistent(cmd::subscribe) && is_consistent(cmd::unsubscribe) &&
+   is_consistent(cmd::psubscribe) && is_consistent(cmd::punsubscribe) &&
+   is_consistent(cmd::ssubscribe) && is_consistent(cmd::sunsubscribe) &&
+   is_consistent(cmd::publish) && is_consistent(cmd::spublish));
+
+} // detail
+
+} // boost::redis
+
+#endif // BOOST_REDIS_COMMAND_HPP
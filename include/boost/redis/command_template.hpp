@@ -0,0 +1,129 @@
+/* Copyright (c) 2018-2024 Marcelo Zimbres Silva (mzimbres@gmail.com)
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See
+ * accompanying file LICENSE.txt)
+ */
+
+#ifndef BOOST_REDIS_COMMAND_TEMPLATE_HPP
+#define BOOST_REDIS_COMMAND_TEMPLATE_HPP
+
+#include <boost/redis/command.hpp>
+#include <boost/throw_exception.hpp>
+
+#include <cstddef>
+#include <stdexcept>
+#include <string_view>
+
+namespace boost::redis {
+
+/** @brief A command with a fixed number of arguments.
+ *  @ingroup high-level-api
+ *
+ *  The RESP3 array header and the command name are serialized once,
+ *  at compile time when the object is `constexpr`, so that
+ *  `request::push` only has to serialize the arguments. For example
+ *
+ *  @code
+ *  constexpr command_template<4> set_ex{"SET"};
+ *
+ *  request req;
+ *  req.push(set_ex, "key", "value", "EX", 10);
+ *  @endcode
+ *
+ *  is equivalent to `req.push("SET", "key", "value", "EX", 10)`. It
+ *  can also be constructed from the catalog e.g.
+ *  `command_template<4>{cmd::set}`.
+ *
+ *  @tparam N Number of arguments of the command.
+ */
+template <std::size_t N>
+class command_template {
+public:
+   /// Number of arguments.
+   static constexpr std::size_t args = N;
+
+   /** @brief Constructor
+    *
+    *  @param cmd The command e.g. Redis or Sentinel command.
+    */
+   constexpr explicit command_template(std::string_view cmd)
+   : responses_{detail::has_response(cmd) ? 0U : 1U}
+   , is_hello_{cmd == "HELLO"}
+   {
+      render(cmd);
+   }
+
+   /** @brief Constructor
+    *
+    *  @param cmd A command from the catalog e.g. `cmd::get`.
+    */
+   constexpr explicit command_template(command const& cmd)
+   : responses_{cmd.responses}
+   , is_hello_{cmd.is_handshake()}
+   {
+      render(cmd.name);
+   }
+
+   /// Returns the serialized array header and command name.
+   [[nodiscard]] constexpr auto prefix() const noexcept -> std::string_view
+      { return {data_, size_}; }
+
+   /// Returns the number of responses delivered to `async_exec`.
+   [[nodiscard]] constexpr auto responses() const noexcept
+      { return responses_; }
+
+   /// Returns true if this is the `HELLO` command.
+   [[nodiscard]] constexpr auto is_hello() const noexcept
+      { return is_hello_; }
+
+private:
+   // Enough for any Redis command name.
+   static constexpr std::size_t capacity = 64;
+
+   constexpr void render(std::string_view cmd)
+   {
+      append('*');
+      append_number(1 + N);
+      append("\r\n$");
+      append_number(std::size(cmd));
+      append("\r\n");
+      append(cmd);
+      append("\r\n");
+   }
+
+   constexpr void append(char c)
+   {
+      if (size_ == capacity)
+         BOOST_THROW_EXCEPTION(std::length_error{"command_template: command too long"});
+
+      data_[size_++] = c;
+   }
+
+   constexpr void append(std::string_view s)
+   {
+      for (auto c: s)
+         append(c);
+   }
+
+   constexpr void append_number(std::size_t n)
+   {
+      char digits[20] = {};
+      std::size_t i = 0;
+      do {
+         digits[i++] = static_cast<char>('0' + n % 10);
+         n /= 10;
+      } while (n != 0);
+
+      while (i != 0)
+         append(digits[--i]);
+   }
+
+   char data_[capacity] = {};
+   std::size_t size_ = 0;
+   std::size_t responses_ = 0;
+   bool is_hello_ = false;
+};
+
+} // boost::redis
+
+#endif // BOOST_REDIS_COMMAND_TEMPLATE_HPP
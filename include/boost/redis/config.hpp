@@ -9,6 +9,7 @@
 
 #include <string>
 #include <chrono>
+#include <cstddef>
 #include <optional>
 
 namespace boost::redis
@@ -34,6 +35,19 @@ struct config {
    /// Address of the Redis server.
    address addr = address{"127.0.0.1", "6379"};
 
+   /** @brief Path of the Unix domain socket of the Redis server.
+    *
+    *  Used instead of `addr` by connections whose stream is a Unix
+    *  domain socket, see `boost::redis::basic_unix_connection`, that
+    *  skip the resolve operation. Must be empty for other streams:
+    *  the default `boost::redis::connection` and
+    *  `boost::redis::basic_tcp_connection` can't connect to it and
+    *  `async_run` fails with `error::unix_sockets_unsupported`. Paths
+    *  that don't fit in a `sockaddr_un`, about 100 bytes, fail with
+    *  `error::unix_socket_path_too_long`.
+    */
+   std::string unix_socket;
+
    /** @brief Username passed to the
     * [HELLO](https://redis.io/commands/hello/) command.  If left
     * empty `HELLO` will be sent without authentication parameters.
@@ -78,6 +92,68 @@ struct config {
     *  To disable reconnection pass zero as duration.
     */
    std::chrono::steady_clock::duration reconnect_wait_interval = std::chrono::seconds{1};
+
+   /** @brief Maximum number of bytes of requests waiting to be written.
+    *
+    *  Once reached, requests passed to `async_exec` are held back,
+    *  i.e. the operation stays suspended, until the bytes waiting to
+    *  be written drop below half this value. Held back requests can
+    *  be cancelled as any other request that hasn't been written. To
+    *  disable the limit pass zero.
+    */
+   std::size_t max_queued_bytes = 0;
+
+   /** @brief Maximum number of commands waiting for a response.
+    *
+    *  Works as `max_queued_bytes` but counts the commands that have
+    *  been passed to `async_exec` and whose responses haven't been
+    *  read yet. To disable the limit pass zero.
+    */
+   std::size_t max_in_flight = 0;
+
+   /** @brief Maximum number of bytes written by a single write operation.
+    *
+    *  Requests that don't fit are written by the next operation, so
+    *  that large flushes are interleaved with reads. A request larger
+    *  than this value is still written in one operation. To disable
+    *  the limit pass zero.
+    */
+   std::size_t max_batch_bytes = 0;
+
+   /** @brief Time the writer waits for more requests before writing.
+    *
+    *  When non-zero, requests passed to `async_exec` while the
+    *  connection is not writing are written after this delay or as
+    *  soon as they add up to `max_batch_bytes`, whichever happens
+    *  first. This trades latency for fewer and larger writes, see
+    *  `usage::write_sizes`. Requests with HELLO priority, such as
+    *  the setup request sent on connection, are never delayed. The
+    *  default of zero writes right away.
+    */
+   std::chrono::steady_clock::duration write_coalesce_delay = std::chrono::steady_clock::duration::zero();
+
+   /** @brief Maximum number of bytes requested by a single read.
+    *
+    *  The size of the reads starts at 4096 bytes and adapts to the
+    *  amount of data available, up to this value. Messages larger
+    *  than that are still read at once. The memory of the read buffer
+    *  is released when it exceeds four times this value, all data in
+    *  it has been parsed and the last 16 messages were all smaller
+    *  than that. See `usage::read_sizes`.
+    */
+   std::size_t max_read_growth = 65536;
+
+   /** @brief Size above which bulk strings are received in chunks.
+    *
+    *  Applies only to responses that accept chunks, see
+    *  `boost::redis::bulk_sink`. Their bulk strings larger than this
+    *  value are passed on as the data arrives and discarded from the
+    *  read buffer right after, so that memory usage is bounded by
+    *  about this value instead of the size of the string. Such bulk
+    *  strings that are read into a `std::string` response are read
+    *  from the socket directly into the string. To disable pass zero.
+    */
+   std::size_t bulk_chunk_size = 65536;
 };
 
 } // boost::redis
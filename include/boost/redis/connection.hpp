@@ -15,10 +15,16 @@
 #include <boost/asio/steady_timer.hpp>
 #include <boost/asio/any_io_executor.hpp>
 #include <boost/asio/any_completion_handler.hpp>
+#include <boost/asio/basic_stream_socket.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
+#include <boost/asio/ssl/context.hpp>
+#include <boost/asio/ssl/stream.hpp>
 
 #include <chrono>
 #include <memory>
 #include <limits>
+#include <type_traits>
 
 namespace boost::redis {
 namespace detail
@@ -58,22 +64,34 @@ struct reconnection_op {
 };
 } // detail
 
-/** @brief A SSL connection to the Redis server.
+/** @brief A connection to the Redis server.
  *  @ingroup high-level-api
  *
  *  This class keeps a healthy connection to the Redis instance where
  *  commands can be sent at any time. For more details, please see the
  *  documentation of each individual function.
  *
- *  @tparam Socket The socket type e.g. asio::ip::tcp::socket.
- *
+ *  @tparam Executor The executor type.
+ *  @tparam Stream The stream type. By default a TCP socket wrapped
+ *  in an `asio::ssl::stream`, that uses SSL when
+ *  `boost::redis::config::use_ssl` is set. Connections that never use
+ *  SSL can pass a plain socket e.g.
+ *  `asio::basic_stream_socket<asio::ip::tcp, Executor>`, see
+ *  `boost::redis::basic_tcp_connection`, in which case no SSL context
+ *  or SSL stream is created and `config::use_ssl` is ignored. For
+ *  Unix domain sockets see `boost::redis::basic_unix_connection`.
  */
-template <class Executor>
+template <
+   class Executor,
+   class Stream = asio::ssl::stream<asio::basic_stream_socket<asio::ip::tcp, Executor>>>
 class basic_connection {
 public:
    /// Executor type.
    using executor_type = Executor;
 
+   /// Type of the next layer.
+   using next_layer_type = Stream;
+
    /// Returns the underlying executor.
    executor_type get_executor() noexcept
       { return impl_.get_executor(); }
@@ -83,16 +101,19 @@ public:
    struct rebind_executor
    {
       /// The connection type when rebound to the specified executor.
-      using other = basic_connection<Executor1>;
+      using other = basic_connection<Executor1, typename detail::rebind_stream<Stream, Executor1>::type>;
    };
 
    /** @brief Constructor
+    *
+    *  Available when the stream has an SSL layer.
     *
     *  @param ex Executor on which connection operation will run.
     *  @param ctx SSL context.
     *  @param max_read_size Maximum read size that is passed to
     *  the internal `asio::dynamic_buffer` constructor.
     */
+   template <class S = Stream, std::enable_if_t<detail::is_ssl_stream<S>::value, int> = 0>
    explicit
    basic_connection(
       executor_type ex,
@@ -103,6 +124,7 @@ public:
    { }
 
    /// Contructs from a context.
+   template <class S = Stream, std::enable_if_t<detail::is_ssl_stream<S>::value, int> = 0>
    explicit
    basic_connection(
       asio::io_context& ioc,
@@ -111,6 +133,32 @@ public:
    : basic_connection(ioc.get_executor(), std::move(ctx), max_read_size)
    { }
 
+   /** @brief Constructor
+    *
+    *  Available when the stream has no SSL layer.
+    *
+    *  @param ex Executor on which connection operation will run.
+    *  @param max_read_size Maximum read size that is passed to
+    *  the internal `asio::dynamic_buffer` constructor.
+    */
+   template <class S = Stream, std::enable_if_t<!detail::is_ssl_stream<S>::value, int> = 0>
+   explicit
+   basic_connection(
+      executor_type ex,
+      std::size_t max_read_size = (std::numeric_limits<std::size_t>::max)())
+   : impl_{ex, max_read_size}
+   , timer_{ex}
+   { }
+
+   /// Contructs from a context.
+   template <class S = Stream, std::enable_if_t<!detail::is_ssl_stream<S>::value, int> = 0>
+   explicit
+   basic_connection(
+      asio::io_context& ioc,
+      std::size_t max_read_size = (std::numeric_limits<std::size_t>::max)())
+   : basic_connection(ioc.get_executor(), max_read_size)
+   { }
+
    /** @brief Starts underlying connection operations.
     *
     *  This member function provides the following functionality
@@ -157,7 +205,7 @@ public:
       Logger l = Logger{},
       CompletionToken token = CompletionToken{})
    {
-      using this_type = basic_connection<executor_type>;
+      using this_type = basic_connection<executor_type, Stream>;
 
       cfg_ = cfg;
       l.set_prefix(cfg_.log_prefix);
@@ -288,7 +336,7 @@ public:
    bool will_reconnect() const noexcept
       { return cfg_.reconnect_wait_interval != std::chrono::seconds::zero();}
 
-   /// Returns the ssl context.
+   /// Returns the ssl context, streams with an SSL layer only.
    auto const& get_ssl_context() const noexcept
       { return impl_.get_ssl_context();}
 
@@ -323,10 +371,32 @@ private:
    template <class, class> friend struct detail::reconnection_op;
 
    config cfg_;
-   detail::connection_base<executor_type> impl_;
+   detail::connection_base<executor_type, Stream> impl_;
    timer_type timer_;
 };
 
+/** @brief A connection over plain TCP, without SSL support.
+ *  @ingroup high-level-api
+ *
+ *  Saves the memory of the SSL context and stream on connections
+ *  that never use SSL.
+ */
+template <class Executor>
+using basic_tcp_connection =
+   basic_connection<Executor, asio::basic_stream_socket<asio::ip::tcp, Executor>>;
+
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+/** @brief A connection over a Unix domain socket.
+ *  @ingroup high-level-api
+ *
+ *  Connects to the socket in `boost::redis::config::unix_socket`
+ *  without resolving any address.
+ */
+template <class Executor>
+using basic_unix_connection =
+   basic_connection<Executor, asio::basic_stream_socket<asio::local::stream_protocol, Executor>>;
+#endif // BOOST_ASIO_HAS_LOCAL_SOCKETS
+
 /** \brief A basic_connection that type erases the executor.
  *  \ingroup high-level-api
  *
@@ -0,0 +1,204 @@
+/* Copyright (c) 2018-2024 Marcelo Zimbres Silva (mzimbres@gmail.com)
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See
+ * accompanying file LICENSE.txt)
+ */
+
+#ifndef BOOST_REDIS_ANY_ADAPTER_HPP
+#define BOOST_REDIS_ANY_ADAPTER_HPP
+
+#include <boost/redis/resp3/node.hpp>
+#include <boost/redis/resp3/parser.hpp>
+#include <boost/assert.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <cstddef>
+#include <new>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace boost::redis::detail
+{
+
+/* Type-erased response adapter.
+ *
+ * Unlike std::function adapters up to inline_size bytes, which
+ * covers the adapters of all but very large responses, are stored
+ * inline. It can be emplaced repeatedly so that objects holding it
+ * can be reused without allocating.
+ *
+ * Besides passing nodes one by one it can run the parse loop itself,
+ * see parse, which is instantiated for each adapter so that a message
+ * costs one indirect call instead of one per node.
+ */
+class any_adapter {
+public:
+   using node_type = resp3::basic_node<std::string_view>;
+
+   static constexpr std::size_t inline_size = 128;
+
+   any_adapter() = default;
+   any_adapter(any_adapter const&) = delete;
+   any_adapter& operator=(any_adapter const&) = delete;
+   ~any_adapter() { reset(); }
+
+   template <class Adapter>
+   void emplace(Adapter adapter)
+   {
+      reset();
+
+      if constexpr (is_inline<Adapter>()) {
+         obj_ = ::new (static_cast<void*>(&storage_)) Adapter(std::move(adapter));
+      } else {
+         obj_ = new Adapter(std::move(adapter));
+      }
+
+      vtable_ = &vtable_for<Adapter>;
+   }
+
+   void operator()(std::size_t i, node_type const& nd, system::error_code& ec)
+   {
+      BOOST_ASSERT(vtable_ != nullptr);
+      vtable_->call(obj_, i, nd, ec);
+   }
+
+   // Parses data into the i-th response, see resp3::parse.
+   auto parse(std::size_t i, resp3::parser& p, std::string_view data, system::error_code& ec) -> bool
+   {
+      BOOST_ASSERT(vtable_ != nullptr);
+      return vtable_->parse(obj_, i, p, data, ec);
+   }
+
+   // Whether the i-th response accepts bulk strings in chunks.
+   [[nodiscard]] auto supports_bulk_chunks(std::size_t i) const noexcept -> bool
+   {
+      BOOST_ASSERT(vtable_ != nullptr);
+      return vtable_->supports_bulk_chunks(obj_, i);
+   }
+
+   // Returns where a bulk string of n bytes that is the i-th
+   // response can be read into, or nullptr.
+   auto bulk_destination(std::size_t i, std::size_t n) -> char*
+   {
+      BOOST_ASSERT(vtable_ != nullptr);
+      return vtable_->bulk_destination(obj_, i, n);
+   }
+
+   void reset() noexcept
+   {
+      if (vtable_ == nullptr)
+         return;
+
+      vtable_->destroy(obj_);
+      vtable_ = nullptr;
+      obj_ = nullptr;
+   }
+
+   [[nodiscard]] auto has_value() const noexcept
+      { return vtable_ != nullptr; }
+
+private:
+   struct vtable {
+      void (*call)(void*, std::size_t, node_type const&, system::error_code&);
+      bool (*parse)(void*, std::size_t, resp3::parser&, std::string_view, system::error_code&);
+      void (*destroy)(void*) noexcept;
+      bool (*supports_bulk_chunks)(void const*, std::size_t) noexcept;
+      char* (*bulk_destination)(void*, std::size_t, std::size_t);
+   };
+
+   template <class Adapter, class = void>
+   struct has_bulk_chunks : std::false_type {};
+
+   template <class Adapter>
+   struct has_bulk_chunks<Adapter, std::void_t<decltype(std::declval<Adapter const&>().supports_bulk_chunks(std::size_t{}))>>
+      : std::true_type {};
+
+   template <class Adapter, class = void>
+   struct has_bulk_destination : std::false_type {};
+
+   template <class Adapter>
+   struct has_bulk_destination<Adapter, std::void_t<decltype(std::declval<Adapter&>().bulk_destination(std::size_t{}, std::size_t{}))>>
+      : std::true_type {};
+
+   struct any_visitor {
+      template <class T>
+      void operator()(T&) const noexcept {}
+   };
+
+   template <class Adapter, class = void>
+   struct has_visit_adapter : std::false_type {};
+
+   template <class Adapter>
+   struct has_visit_adapter<Adapter, std::void_t<decltype(std::declval<Adapter&>().visit_adapter(std::size_t{}, any_visitor{}))>>
+      : std::true_type {};
+
+   template <class Adapter>
+   static constexpr auto is_inline() noexcept
+   {
+      return sizeof(Adapter) <= inline_size
+          && alignof(std::max_align_t) % alignof(Adapter) == 0
+          && std::is_nothrow_move_constructible<Adapter>::value;
+   }
+
+   template <class Adapter>
+   static void call(void* p, std::size_t i, node_type const& nd, system::error_code& ec)
+      { (*static_cast<Adapter*>(p))(i, nd, ec); }
+
+   // Adapters of several responses e.g. static_adapter are resolved
+   // to the adapter of the i-th response once, before parsing. That
+   // adapter is passed to resp3::parse as is, so that it can also
+   // receive the raw message.
+   template <class Adapter>
+   static auto parse_with(void* p, std::size_t i, resp3::parser& parser, std::string_view data, system::error_code& ec) -> bool
+   {
+      auto& adapter = *static_cast<Adapter*>(p);
+
+      if constexpr (has_visit_adapter<Adapter>::value) {
+         return adapter.visit_adapter(i, [&](auto& elem) {
+            return resp3::parse(parser, data, elem, ec);
+         });
+      } else {
+         auto f = [&adapter, i](node_type const& nd, system::error_code& ec2) { adapter(i, nd, ec2); };
+         return resp3::parse(parser, data, f, ec);
+      }
+   }
+
+   template <class Adapter>
+   static void destroy(void* p) noexcept
+   {
+      if constexpr (is_inline<Adapter>())
+         static_cast<Adapter*>(p)->~Adapter();
+      else
+         delete static_cast<Adapter*>(p);
+   }
+
+   template <class Adapter>
+   static auto bulk_chunks_of(void const* p, std::size_t i) noexcept -> bool
+   {
+      if constexpr (has_bulk_chunks<Adapter>::value)
+         return static_cast<Adapter const*>(p)->supports_bulk_chunks(i);
+      else
+         return false;
+   }
+
+   template <class Adapter>
+   static auto bulk_destination_of(void* p, std::size_t i, std::size_t n) -> char*
+   {
+      if constexpr (has_bulk_destination<Adapter>::value)
+         return static_cast<Adapter*>(p)->bulk_destination(i, n);
+      else
+         return nullptr;
+   }
+
+   template <class Adapter>
+   static constexpr vtable vtable_for{&call<Adapter>, &parse_with<Adapter>, &destroy<Adapter>, &bulk_chunks_of<Adapter>, &bulk_destination_of<Adapter>};
+
+   alignas(std::max_align_t) unsigned char storage_[inline_size];
+   void* obj_ = nullptr;
+   vtable const* vtable_ = nullptr;
+};
+
+} // boost::redis::detail
+
+#endif // BOOST_REDIS_ANY_ADAPTER_HPP
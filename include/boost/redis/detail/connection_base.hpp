@@ -16,6 +16,10 @@
 #include <boost/redis/config.hpp>
 #include <boost/redis/detail/runner.hpp>
 #include <boost/redis/usage.hpp>
+#include <boost/redis/detail/read_buffer.hpp>
+#include <boost/redis/detail/any_adapter.hpp>
+#include <boost/redis/detail/intrusive_list.hpp>
+#include <boost/redis/detail/stream_holder.hpp>
 
 #include <boost/system.hpp>
 #include <boost/asio/basic_stream_socket.hpp>
@@ -26,43 +30,40 @@
 #include <boost/asio/write.hpp>
 #include <boost/assert.hpp>
 #include <boost/core/ignore_unused.hpp>
-#include <boost/asio/ssl/stream.hpp>
+#include <boost/asio/read.hpp>
 #include <boost/asio/read_until.hpp>
 #include <boost/asio/buffer.hpp>
 #include <boost/asio/experimental/channel.hpp>
+#include <boost/asio/post.hpp>
 
 #include <algorithm>
 #include <array>
 #include <chrono>
-#include <deque>
+#include <cstddef>
 #include <memory>
+#include <string>
 #include <string_view>
 #include <type_traits>
 #include <functional>
+#include <utility>
+#include <vector>
 
 namespace boost::redis::detail
 {
 
-template <class DynamicBuffer>
-std::string_view buffer_view(DynamicBuffer buf) noexcept
-{
-   char const* start = static_cast<char const*>(buf.data(0, buf.size()).data());
-   return std::string_view{start, std::size(buf)};
-}
-
 template <class AsyncReadStream, class DynamicBuffer>
 class append_some_op {
 private:
    AsyncReadStream& stream_;
-   DynamicBuffer buf_;
+   DynamicBuffer& buf_;
    std::size_t size_ = 0;
    std::size_t tmp_ = 0;
    asio::coroutine coro_{};
 
 public:
-   append_some_op(AsyncReadStream& stream, DynamicBuffer buf, std::size_t size)
+   append_some_op(AsyncReadStream& stream, DynamicBuffer& buf, std::size_t size)
    : stream_ {stream}
-   , buf_ {std::move(buf)}
+   , buf_ {buf}
    , size_{size}
    { }
 
@@ -93,7 +94,7 @@ template <class AsyncReadStream, class DynamicBuffer, class CompletionToken>
 auto
 async_append_some(
    AsyncReadStream& stream,
-   DynamicBuffer buffer,
+   DynamicBuffer& buffer,
    std::size_t size,
    CompletionToken&& token)
 {
@@ -105,11 +106,10 @@ async_append_some(
 
 template <class Conn>
 struct exec_op {
-   using req_info_type = typename Conn::req_info;
-   using adapter_type = typename Conn::adapter_type;
+   using req_info_ptr = typename Conn::req_info_ptr;
 
    Conn* conn_ = nullptr;
-   std::shared_ptr<req_info_type> info_ = nullptr;
+   req_info_ptr info_;
    asio::coroutine coro{};
 
    template <class Self>
@@ -143,7 +143,7 @@ EXEC_OP_WAIT:
          }
 
          if (is_cancelled(self)) {
-            if (!info_->is_waiting()) {
+            if (!info_->is_waiting() && !info_->is_blocked()) {
                using c_t = asio::cancellation_type;
                auto const c = self.get_cancellation_state().cancelled();
                if ((c & c_t::terminal) != c_t::none) {
@@ -213,6 +213,15 @@ struct run_op {
    }
 };
 
+// Loggers that provide on_write(ec, n), otherwise they are passed
+// the payload, see logger::on_write.
+template <class Logger, class = void>
+struct logs_write_size : std::false_type {};
+
+template <class Logger>
+struct logs_write_size<Logger, std::void_t<decltype(std::declval<Logger&>().on_write(std::declval<system::error_code const&>(), std::declval<std::size_t>()))>>
+   : std::true_type {};
+
 template <class Conn, class Logger>
 struct writer_op {
    Conn* conn_;
@@ -224,17 +233,30 @@ struct writer_op {
                   , system::error_code ec = {}
                   , std::size_t n = 0)
    {
-      ignore_unused(n);
-
       BOOST_ASIO_CORO_REENTER (coro) for (;;)
       {
+         // Gives other requests the chance to join the batch, see
+         // config::write_coalesce_delay.
+         if (conn_->must_cork()) {
+            BOOST_ASIO_CORO_YIELD
+            conn_->async_wait_cork(std::move(self));
+            if (!conn_->is_open() || is_cancelled(self)) {
+               logger_.trace("writer-op: canceled (4). Exiting ...");
+               self.complete({});
+               return;
+            }
+         }
+
          while (conn_->coalesce_requests()) {
-            if (conn_->use_ssl())
-               BOOST_ASIO_CORO_YIELD asio::async_write(conn_->next_layer(), asio::buffer(conn_->write_buffer_), std::move(self));
-            else
-               BOOST_ASIO_CORO_YIELD asio::async_write(conn_->next_layer().next_layer(), asio::buffer(conn_->write_buffer_), std::move(self));
+            BOOST_ASIO_CORO_YIELD
+            conn_->with_stream([conn = conn_, &self](auto& stream) {
+               asio::async_write(stream, conn->get_write_buffers(), std::move(self));
+            });
 
-            logger_.on_write(ec, conn_->write_buffer_);
+            if constexpr (logs_write_size<Logger>::value)
+               logger_.on_write(ec, n);
+            else
+               logger_.on_write(ec, conn_->get_write_payload());
 
             if (ec) {
                logger_.trace("writer-op: error. Exiting ...");
@@ -289,30 +311,36 @@ struct reader_op {
                   , system::error_code ec = {}
                   , std::size_t n = 0)
    {
-      ignore_unused(n);
-
       BOOST_ASIO_CORO_REENTER (coro) for (;;)
       {
          // Appends some data to the buffer if necessary.
          if ((res_.first == parse_result::needs_more) || std::empty(conn_->read_buffer_)) {
-            if (conn_->use_ssl()) {
+            if (conn_->is_direct_read_pending()) {
+               // The rest of a large bulk string goes straight into
+               // the response, see bulk_destination.
                BOOST_ASIO_CORO_YIELD
-               async_append_some(
-                  conn_->next_layer(),
-                  conn_->dbuf_,
-                  conn_->get_suggested_buffer_growth(),
-                  std::move(self));
+               conn_->with_stream([conn = conn_, &self](auto& stream) {
+                  asio::async_read(stream, conn->get_direct_buffer(), std::move(self));
+               });
+
+               logger_.on_read(ec, n);
+               if (!ec)
+                  conn_->on_direct_read(n);
             } else {
                BOOST_ASIO_CORO_YIELD
-               async_append_some(
-                  conn_->next_layer().next_layer(),
-                  conn_->dbuf_,
-                  conn_->get_suggested_buffer_growth(),
-                  std::move(self));
+               conn_->with_stream([conn = conn_, &self](auto& stream) {
+                  async_append_some(
+                     stream,
+                     conn->read_buffer_,
+                     conn->get_suggested_buffer_growth(),
+                     std::move(self));
+               });
+
+               logger_.on_read(ec, n);
+               if (!ec)
+                  conn_->on_append(n);
             }
 
-            logger_.on_read(ec, n);
-
             // EOF is not treated as error.
             if (ec == asio::error::eof) {
                logger_.trace("reader-op: EOF received. Exiting ...");
@@ -338,7 +366,7 @@ struct reader_op {
             }
          }
 
-         res_ = conn_->on_read(buffer_view(conn_->dbuf_), ec);
+         res_ = conn_->on_read(conn_->read_buffer_.view(), ec);
          if (ec) {
             logger_.trace("reader-op: parse error. Exiting ...");
             conn_->cancel(operation::run);
@@ -374,54 +402,61 @@ struct reader_op {
  *  @ingroup high-level-api
  *
  *  @tparam Executor The executor type.
+ *  @tparam Stream The stream type e.g. `asio::ip::tcp::socket` or
+ *  `asio::ssl::stream<asio::ip::tcp::socket>`.
  *
  */
-template <class Executor>
+template <class Executor, class Stream>
 class connection_base {
 public:
    /// Executor type
    using executor_type = Executor;
 
    /// Type of the next layer
-   using next_layer_type = asio::ssl::stream<asio::basic_stream_socket<asio::ip::tcp, Executor>>;
+   using next_layer_type = Stream;
+
+   /// True when the stream has an SSL layer.
+   static constexpr bool has_ssl_layer = is_ssl_stream<Stream>::value;
+
+   /// True when the stream is a Unix domain socket.
+   static constexpr bool has_local_stream = is_local_stream<Stream>::value;
 
    using clock_type = std::chrono::steady_clock;
    using clock_traits_type = asio::wait_traits<clock_type>;
    using timer_type = asio::basic_waitable_timer<clock_type, clock_traits_type, executor_type>;
 
-   using this_type = connection_base<Executor>;
+   using this_type = connection_base<Executor, Stream>;
 
-   /// Constructs from an executor.
+   /// Constructs from an executor and the SSL context, SSL streams only.
+   template <class S = Stream, std::enable_if_t<is_ssl_stream<S>::value, int> = 0>
    connection_base(
       executor_type ex,
       asio::ssl::context ctx,
       std::size_t max_read_size)
-   : ctx_{std::move(ctx)}
-   , stream_{std::make_unique<next_layer_type>(ex, ctx_)}
-   , writer_timer_{ex}
-   , receive_channel_{ex, 256}
-   , runner_{ex, {}}
-   , dbuf_{read_buffer_, max_read_size}
-   {
-      set_receive_response(ignore);
-      writer_timer_.expires_at((std::chrono::steady_clock::time_point::max)());
-   }
+   : connection_base{ex, stream_holder_type{ex, std::move(ctx)}, max_read_size}
+   { }
+
+   /// Constructs from an executor, streams without an SSL layer only.
+   template <class S = Stream, std::enable_if_t<!is_ssl_stream<S>::value, int> = 0>
+   connection_base(
+      executor_type ex,
+      std::size_t max_read_size)
+   : connection_base{ex, stream_holder_type{ex}, max_read_size}
+   { }
 
    /// Returns the ssl context.
    auto const& get_ssl_context() const noexcept
-      { return ctx_;}
+      { return stream_.get_ssl_context();}
 
    /// Resets the underlying stream.
    void reset_stream()
-   {
-      stream_ = std::make_unique<next_layer_type>(writer_timer_.get_executor(), ctx_);
-   }
+      { stream_.reset(); }
 
    /// Returns a reference to the next layer.
-   auto& next_layer() noexcept { return *stream_; }
+   auto& next_layer() noexcept { return stream_.get(); }
 
    /// Returns a const reference to the next layer.
-   auto const& next_layer() const noexcept { return *stream_; }
+   auto const& next_layer() const noexcept { return stream_.get(); }
 
    /// Returns the associated executor.
    auto get_executor() {return writer_timer_.get_executor();}
@@ -447,7 +482,8 @@ public:
       auto f = boost_redis_adapt(resp);
       BOOST_ASSERT_MSG(req.get_expected_responses() <= f.get_supported_response_size(), "Request and response have incompatible sizes.");
 
-      auto info = std::make_shared<req_info>(req, f, get_executor());
+      req_info_ptr info{req_pool_->acquire(get_executor())};
+      info->prepare(req, f);
 
       return asio::async_compose
          < CompletionToken
@@ -499,8 +535,7 @@ public:
    void set_receive_response(Response& response)
    {
       using namespace boost::redis::adapter;
-      auto g = boost_redis_adapt(response);
-      receive_adapter_ = adapter::detail::make_adapter_wrapper(g);
+      receive_adapter_.emplace(boost_redis_adapt(response));
    }
 
    usage get_usage() const noexcept
@@ -512,61 +547,113 @@ public:
 private:
    using receive_channel_type = asio::experimental::channel<executor_type, void(system::error_code, std::size_t)>;
    using runner_type = runner<executor_type>;
-   using adapter_type = std::function<void(std::size_t, resp3::basic_node<std::string_view> const&, system::error_code&)>;
-   using receiver_adapter_type = std::function<void(resp3::basic_node<std::string_view> const&, system::error_code&)>;
-   using exec_notifier_type = receive_channel_type;
 
+   using stream_holder_type = stream_holder<Stream>;
+
+   connection_base(
+      executor_type ex,
+      stream_holder_type stream,
+      std::size_t max_read_size)
+   : stream_{std::move(stream)}
+   , writer_timer_{ex}
+   , cork_timer_{ex}
+   , receive_channel_{ex, 256}
+   , runner_{ex, {}}
+   , read_buffer_{max_read_size}
+   {
+      set_receive_response(ignore);
+      writer_timer_.expires_at((std::chrono::steady_clock::time_point::max)());
+   }
+
+   // config::use_ssl is ignored by streams without an SSL layer.
    auto use_ssl() const noexcept
-      { return runner_.get_config().use_ssl;}
+   {
+      if constexpr (has_ssl_layer)
+         return runner_.get_config().use_ssl;
+      else
+         return false;
+   }
+
+   // Calls f with the stream reads and writes go through, that is
+   // the SSL stream only when SSL is in use.
+   template <class F>
+   void with_stream(F&& f)
+   {
+      if constexpr (has_ssl_layer) {
+         if (use_ssl())
+            f(next_layer());
+         else
+            f(next_layer().next_layer());
+      } else {
+         f(next_layer());
+      }
+   }
 
    auto cancel_on_conn_lost() -> std::size_t
    {
       // Must return false if the request should be removed.
-      auto cond = [](auto const& ptr)
+      auto cond = [](req_info const& ri)
       {
-         BOOST_ASSERT(ptr != nullptr);
-
-         if (ptr->is_waiting()) {
-            return !ptr->req_->get_config().cancel_on_connection_lost;
+         if (ri.is_waiting() || ri.is_blocked()) {
+            return !ri.req_->get_config().cancel_on_connection_lost;
          } else {
-            return !ptr->req_->get_config().cancel_if_unresponded;
+            return !ri.req_->get_config().cancel_if_unresponded;
          }
       };
 
-      auto point = std::stable_partition(std::begin(reqs_), std::end(reqs_), cond);
+      // Requests that are kept will be written again after
+      // reconnection, hence they become waiting in their original
+      // order.
+      request_queue::list_type kept;
+      std::size_t ret = 0;
 
-      auto const ret = std::distance(point, std::end(reqs_));
-
-      std::for_each(point, std::end(reqs_), [](auto const& ptr) {
-         ptr->stop();
-      });
+      auto f = [&](req_info& ri)
+      {
+         if (cond(ri)) {
+            if (ri.is_written())
+               reqs_.unwritten_bytes += ri.size_;
 
-      reqs_.erase(point, std::end(reqs_));
+            request_queue::list_type::unlink(ri);
+            ri.mark_waiting();
+            kept.push_back(ri);
+         } else {
+            ri.stop();
+            reqs_.erase(ri);
+            ++ret;
+         }
+      };
 
-      std::for_each(std::begin(reqs_), std::end(reqs_), [](auto const& ptr) {
-         return ptr->mark_waiting();
+      reqs_.written.for_each(f);
+      reqs_.staged.for_each(f);
+      reqs_.waiting.for_each(f);
+      reqs_.waiting.splice_back(kept);
+
+      // Blocked requests stay blocked.
+      reqs_.blocked.for_each([&](req_info& ri) {
+         if (!cond(ri)) {
+            ri.stop();
+            reqs_.erase(ri);
+            ++ret;
+         }
       });
 
+      release_blocked();
       return ret;
    }
 
    auto cancel_unwritten_requests() -> std::size_t
    {
-      auto f = [](auto const& ptr)
-      {
-         BOOST_ASSERT(ptr != nullptr);
-         return !ptr->is_waiting();
+      std::size_t ret = 0;
+      auto f = [&](req_info& ri) {
+         ri.stop();
+         reqs_.erase(ri);
+         ++ret;
       };
 
-      auto point = std::stable_partition(std::begin(reqs_), std::end(reqs_), f);
+      reqs_.waiting.for_each(f);
+      reqs_.blocked.for_each(f);
+      release_blocked();
 
-      auto const ret = std::distance(point, std::end(reqs_));
-
-      std::for_each(point, std::end(reqs_), [](auto const& ptr) {
-         ptr->stop();
-      });
-
-      reqs_.erase(point, std::end(reqs_));
       return ret;
    }
 
@@ -587,6 +674,7 @@ private:
 
             close();
             writer_timer_.cancel();
+            cork_timer_.cancel();
             receive_channel_.cancel();
             cancel_on_conn_lost();
          } break;
@@ -600,52 +688,88 @@ private:
 
    void on_write()
    {
-      // We have to clear the payload right after writing it to use it
-      // as a flag that informs there is no ongoing write.
+      // We have to clear the buffers right after writing them to use
+      // them as a flag that informs there is no ongoing write.
       write_buffer_.clear();
+      write_buffers_.clear();
 
-      // Notice this must come before the for-each below.
+      // Notice this must come before the requests are marked as
+      // written below.
       cancel_push_requests();
 
-      // There is small optimization possible here: traverse only the
-      // partition of unwritten requests instead of them all.
-      std::for_each(std::begin(reqs_), std::end(reqs_), [](auto const& ptr) {
-         BOOST_ASSERT_MSG(ptr != nullptr, "Expects non-null pointer.");
-         if (ptr->is_staged()) {
-            ptr->mark_written();
-         }
+      reqs_.staged.for_each([this](req_info& ri) {
+         reqs_.unwritten_bytes -= ri.size_;
+         ri.mark_written();
       });
+
+      reqs_.written.splice_back(reqs_.staged);
+      release_blocked();
    }
 
-   struct req_info {
+   struct req_info_pool;
+
+   // The state of a call to async_exec. Instances are recycled by
+   // req_info_pool, hence everything is (re)initialized in prepare.
+   struct req_info : list_hook {
    public:
       using node_type = resp3::basic_node<std::string_view>;
-      using wrapped_adapter_type = std::function<void(node_type const&, system::error_code&)>;
-
-      explicit req_info(request const& req, adapter_type adapter, executor_type ex)
-      : notifier_{ex, 1}
-      , req_{&req}
-      , adapter_{}
-      , expected_responses_{req.get_expected_responses()}
-      , status_{status::waiting}
-      , ec_{{}}
-      , read_size_{0}
+
+      explicit req_info(executor_type ex)
+      : timer_{ex}
       {
-         adapter_ = [this, adapter](node_type const& nd, system::error_code& ec)
-         {
-            auto const i = req_->get_expected_responses() - expected_responses_;
-            adapter(i, nd, ec);
-         };
+         timer_.expires_at((std::chrono::steady_clock::time_point::max)());
       }
 
-      auto proceed()
+      template <class Adapter>
+      void prepare(request const& req, Adapter adapter)
       {
-         notifier_.try_send(std::error_code{}, 0);
+         req_ = &req;
+         adapter_.emplace(std::move(adapter));
+         expected_responses_ = req.get_expected_responses();
+         size_ = req.size();
+         status_ = status::waiting;
+         ec_ = {};
+         read_size_ = 0;
+         done_ = false;
+         stopped_ = false;
+      }
+
+      // Forwards nodes to the adapter with the index of the command
+      // they belong to.
+      void adapt(node_type const& nd, system::error_code& ec)
+      {
+         adapter_(index(), nd, ec);
+      }
+
+      // Parses data into the response of the command being read,
+      // with one type-erased call rather than one per node.
+      auto parse(resp3::parser& p, std::string_view data, system::error_code& ec) -> bool
+         { return adapter_.parse(index(), p, data, ec); }
+
+      // Whether the response being read accepts bulk strings in
+      // chunks, see bulk_sink.
+      [[nodiscard]] auto supports_bulk_chunks() const noexcept
+         { return adapter_.supports_bulk_chunks(index()); }
+
+      // Where the response being read wants a bulk string of n bytes
+      // to be written, nullptr if it should be passed as usual.
+      auto bulk_destination(std::size_t n) -> char*
+         { return adapter_.bulk_destination(index(), n); }
+
+      // Index of the command whose response is being read.
+      [[nodiscard]] auto index() const noexcept
+         { return req_->get_expected_responses() - expected_responses_; }
+
+      void proceed()
+      {
+         done_ = true;
+         timer_.cancel();
       }
 
       void stop()
       {
-         notifier_.close();
+         stopped_ = true;
+         timer_.cancel();
       }
 
       [[nodiscard]] auto is_waiting() const noexcept
@@ -657,6 +781,9 @@ private:
       [[nodiscard]] auto is_staged() const noexcept
          { return status_ == status::staged; }
 
+      [[nodiscard]] auto is_blocked() const noexcept
+         { return status_ == status::blocked; }
+
       void mark_written() noexcept
          { status_ = status::written; }
 
@@ -666,41 +793,252 @@ private:
       void mark_waiting() noexcept
          { status_ = status::waiting; }
 
+      void mark_blocked() noexcept
+         { status_ = status::blocked; }
+
       [[nodiscard]] auto stop_requested() const noexcept
-         { return !notifier_.is_open();}
+         { return stopped_;}
 
+      // Completes once proceed or stop has been called, including
+      // when that happened before the wait started.
       template <class CompletionToken>
       auto async_wait(CompletionToken token)
       {
-         return notifier_.async_receive(std::move(token));
+         if (done_ || stopped_)
+            return asio::post(std::move(token));
+
+         return timer_.async_wait(std::move(token));
       }
 
    //private:
       enum class status
-      { waiting
+      { blocked
+      , waiting
       , staged
       , written
       };
 
-      exec_notifier_type notifier_;
-      request const* req_;
-      wrapped_adapter_type adapter_;
+      // Notice we use a timer to simulate a condition-variable, as
+      // for the writer. Unlike a channel it does not allocate.
+      timer_type timer_;
+      request const* req_ = nullptr;
+      any_adapter adapter_;
 
       // Contains the number of commands that haven't been read yet.
-      std::size_t expected_responses_;
-      status status_;
+      std::size_t expected_responses_ = 0;
+
+      // Size of the serialized request.
+      std::size_t size_ = 0;
+      status status_ = status::waiting;
 
       system::error_code ec_;
-      std::size_t read_size_;
+      std::size_t read_size_ = 0;
+      bool done_ = false;
+      bool stopped_ = false;
+
+      // Intrusive reference count, see req_info_ptr.
+      std::size_t refs_ = 0;
+
+      // Set while the object is in use so that the pool outlives it.
+      std::shared_ptr<req_info_pool> pool_;
    };
 
-   void remove_request(std::shared_ptr<req_info> const& info)
+   // Free list of req_info objects. It is shared with the objects in
+   // use since exec operations might outlive the connection.
+   struct req_info_pool : std::enable_shared_from_this<req_info_pool> {
+      std::vector<std::unique_ptr<req_info>> free_;
+
+      auto acquire(executor_type ex) -> req_info*
+      {
+         std::unique_ptr<req_info> info;
+         if (std::empty(free_)) {
+            info = std::make_unique<req_info>(ex);
+         } else {
+            info = std::move(free_.back());
+            free_.pop_back();
+         }
+
+         info->pool_ = this->shared_from_this();
+         return info.release();
+      }
+
+      static void recycle(req_info* info) noexcept
+      {
+         BOOST_ASSERT(!info->is_linked());
+         std::unique_ptr<req_info> p{info};
+         p->adapter_.reset();
+         p->req_ = nullptr;
+
+         // Free objects do not own the pool, which may be destroyed
+         // right below if this was the last object in use.
+         auto const pool = std::move(p->pool_);
+         try {
+            pool->free_.push_back(std::move(p));
+         } catch (...) {
+         }
+      }
+   };
+
+   // Shared ownership of a req_info that returns it to its pool
+   // instead of deleting it.
+   class req_info_ptr {
+   public:
+      req_info_ptr() = default;
+
+      explicit req_info_ptr(req_info* p) noexcept
+      : p_{p}
+      {
+         if (p_)
+            ++p_->refs_;
+      }
+
+      req_info_ptr(req_info_ptr const& other) noexcept
+      : req_info_ptr{other.p_}
+      { }
+
+      req_info_ptr(req_info_ptr&& other) noexcept
+      : p_{std::exchange(other.p_, nullptr)}
+      { }
+
+      req_info_ptr& operator=(req_info_ptr other) noexcept
+      {
+         std::swap(p_, other.p_);
+         return *this;
+      }
+
+      ~req_info_ptr()
+      {
+         if (p_ && --p_->refs_ == 0)
+            req_info_pool::recycle(p_);
+      }
+
+      // Releases ownership without decrementing the count.
+      auto detach() noexcept -> req_info*
+         { return std::exchange(p_, nullptr); }
+
+      // Takes ownership of a reference released with detach.
+      static auto adopt(req_info* p) noexcept -> req_info_ptr
+      {
+         req_info_ptr ret;
+         ret.p_ = p;
+         return ret;
+      }
+
+      auto operator->() const noexcept { return p_; }
+      auto& operator*() const noexcept { return *p_; }
+
+      friend bool operator==(req_info_ptr const& a, req_info_ptr const& b) noexcept
+         { return a.p_ == b.p_; }
+      friend bool operator!=(req_info_ptr const& a, req_info_ptr const& b) noexcept
+         { return a.p_ != b.p_; }
+      friend bool operator!=(req_info_ptr const& a, std::nullptr_t) noexcept
+         { return a.p_ != nullptr; }
+
+   private:
+      req_info* p_ = nullptr;
+   };
+
+   // Requests in the order they are written and responded to, split
+   // in segments by status. Each segment is an intrusive list that
+   // owns a reference to its requests, so changing the status of
+   // requests or removing one never traverses the others.
+   struct request_queue {
+      using list_type = intrusive_list<req_info>;
+
+      list_type written;
+      list_type staged;
+      list_type waiting;
+
+      // Requests held back by the limits in the config, they are not
+      // part of the queue proper until admitted, see release_blocked.
+      list_type blocked;
+
+      // Bytes of the admitted requests that haven't been written and
+      // number of responses they are still expecting.
+      std::size_t unwritten_bytes = 0;
+      std::size_t pending_responses = 0;
+
+      request_queue() = default;
+      request_queue(request_queue const&) = delete;
+      request_queue& operator=(request_queue const&) = delete;
+
+      ~request_queue()
+      {
+         auto f = [this](req_info& ri) { erase(ri); };
+         written.for_each(f);
+         staged.for_each(f);
+         waiting.for_each(f);
+         blocked.for_each(f);
+      }
+
+      void push(req_info_ptr info, bool front)
+         { admit(*info.detach(), front); }
+
+      void push_blocked(req_info_ptr info)
+      {
+         auto* ri = info.detach();
+         ri->mark_blocked();
+         blocked.push_back(*ri);
+      }
+
+      // Links an unlinked request at the end (or front) of the
+      // waiting list.
+      void admit(req_info& ri, bool front = false)
+      {
+         ri.mark_waiting();
+         if (front)
+            waiting.push_front(ri);
+         else
+            waiting.push_back(ri);
+
+         unwritten_bytes += ri.size_;
+         pending_responses += ri.expected_responses_;
+      }
+
+      [[nodiscard]] auto empty() const noexcept
+         { return written.empty() && staged.empty() && waiting.empty(); }
+
+      // Responses may arrive while their requests are still marked
+      // as staged, see https://github.com/boostorg/redis/issues/170
+      [[nodiscard]] auto front() noexcept -> req_info&
+      {
+         if (!written.empty())
+            return written.front();
+
+         if (!staged.empty())
+            return staged.front();
+
+         return waiting.front();
+      }
+
+      [[nodiscard]] auto front() const noexcept -> req_info const&
+         { return const_cast<request_queue&>(*this).front(); }
+
+      void pop_front() noexcept
+         { erase(front()); }
+
+      // Unlinks the request and releases the queue's reference.
+      void erase(req_info& ri) noexcept
+      {
+         if (!ri.is_blocked()) {
+            if (!ri.is_written())
+               unwritten_bytes -= ri.size_;
+            pending_responses -= ri.expected_responses_;
+         }
+
+         list_type::unlink(ri);
+         req_info_ptr::adopt(&ri);
+      }
+   };
+
+   void remove_request(req_info_ptr const& info)
    {
-      reqs_.erase(std::remove(std::begin(reqs_), std::end(reqs_), info));
+      if (info->is_linked()) {
+         reqs_.erase(*info);
+         release_blocked();
+      }
    }
 
-   using reqs_type = std::deque<std::shared_ptr<req_info>>;
-
    template <class, class> friend struct reader_op;
    template <class, class> friend struct writer_op;
    template <class, class> friend struct run_op;
@@ -709,36 +1047,137 @@ private:
 
    void cancel_push_requests()
    {
-      auto point = std::stable_partition(std::begin(reqs_), std::end(reqs_), [](auto const& ptr) {
-            return !(ptr->is_staged() && ptr->req_->get_expected_responses() == 0);
-      });
-
-      std::for_each(point, std::end(reqs_), [](auto const& ptr) {
-         ptr->proceed();
+      reqs_.staged.for_each([this](req_info& ri) {
+         if (ri.req_->get_expected_responses() == 0) {
+            ri.proceed();
+            reqs_.erase(ri);
+         }
       });
-
-      reqs_.erase(point, std::end(reqs_));
    }
 
    [[nodiscard]] bool is_writing() const noexcept
    {
-      return !write_buffer_.empty();
+      return !write_buffers_.empty();
    }
 
-   void add_request_info(std::shared_ptr<req_info> const& info)
+   // Buffer sequence that refers to write_buffers_ without copying
+   // it into the write operation.
+   struct buffers_view {
+      asio::const_buffer const* first;
+      asio::const_buffer const* last;
+      auto begin() const noexcept { return first; }
+      auto end() const noexcept { return last; }
+   };
+
+   [[nodiscard]] auto get_write_buffers() const noexcept -> buffers_view
    {
-      reqs_.push_back(info);
+      return {write_buffers_.data(), write_buffers_.data() + write_buffers_.size()};
+   }
 
-      if (info->req_->has_hello_priority()) {
-         auto rend = std::partition_point(std::rbegin(reqs_), std::rend(reqs_), [](auto const& e) {
-               return e->is_waiting();
-         });
+   // Copy of the data in the write buffers, for loggers that take
+   // the payload.
+   [[nodiscard]] auto get_write_payload() const -> std::string
+   {
+      auto const buffers = get_write_buffers();
+      std::string ret(asio::buffer_size(buffers), '\0');
+      asio::buffer_copy(asio::buffer(ret), buffers);
+      return ret;
+   }
 
-         std::rotate(std::rbegin(reqs_), std::rbegin(reqs_) + 1, rend);
+   void add_request_info(req_info_ptr const& info)
+   {
+      // Requests with HELLO go in front of all other requests that
+      // haven't been written yet and are never held back, otherwise
+      // the handshake could wait for requests that can only be
+      // written after it.
+      auto const hello = info->req_->has_hello_priority();
+      if (!hello && (throttled_ || !reqs_.blocked.empty())) {
+         reqs_.push_blocked(info);
+         return;
       }
 
-      if (is_open() && !is_writing())
-         writer_timer_.cancel();
+      reqs_.push(info, hello);
+      throttled_ = !has_capacity();
+      notify_writer();
+   }
+
+   void notify_writer()
+   {
+      if (!is_open() || is_writing())
+         return;
+
+      writer_timer_.cancel();
+      if (!must_cork())
+         cork_timer_.cancel();
+   }
+
+   [[nodiscard]] auto is_batch_full() const noexcept
+   {
+      auto const max_batch = runner_.get_config().max_batch_bytes;
+      return max_batch != 0 && reqs_.unwritten_bytes >= max_batch;
+   }
+
+   // Whether the writer should wait for more requests before writing
+   // the ones waiting. Requests with HELLO priority are written right
+   // away, delaying them would delay the handshake at connection
+   // start, see add_request_info.
+   [[nodiscard]] auto must_cork() const noexcept
+   {
+      return runner_.get_config().write_coalesce_delay != std::chrono::steady_clock::duration::zero()
+          && !reqs_.waiting.empty()
+          && !reqs_.waiting.front().req_->has_hello_priority()
+          && !is_batch_full();
+   }
+
+   // Completes after the coalesce delay or earlier, when the batch
+   // is full.
+   template <class CompletionToken>
+   auto async_wait_cork(CompletionToken&& token)
+   {
+      cork_timer_.expires_after(runner_.get_config().write_coalesce_delay);
+      return cork_timer_.async_wait(std::forward<CompletionToken>(token));
+   }
+
+   // Whether the admitted requests are below the limits in the
+   // config. A request is admitted while that is the case, even if
+   // it exceeds the limits itself.
+   [[nodiscard]] auto has_capacity() const noexcept
+   {
+      auto const& cfg = runner_.get_config();
+      return (cfg.max_queued_bytes == 0 || reqs_.unwritten_bytes < cfg.max_queued_bytes)
+          && (cfg.max_in_flight == 0 || reqs_.pending_responses < cfg.max_in_flight);
+   }
+
+   // The low-water marks are half the limits, so that blocked
+   // requests are admitted in batches rather than one at a time.
+   [[nodiscard]] auto is_below_low_water() const noexcept
+   {
+      auto const& cfg = runner_.get_config();
+      return (cfg.max_queued_bytes == 0 || reqs_.unwritten_bytes <= cfg.max_queued_bytes / 2)
+          && (cfg.max_in_flight == 0 || reqs_.pending_responses <= cfg.max_in_flight / 2);
+   }
+
+   // Admits blocked requests in order once the queue has drained
+   // below the low-water marks.
+   void release_blocked()
+   {
+      if (!throttled_ || !is_below_low_water())
+         return;
+
+      throttled_ = false;
+      bool released = false;
+      reqs_.blocked.for_each([&](req_info& ri) {
+         if (throttled_)
+            return;
+
+         request_queue::list_type::unlink(ri);
+         reqs_.admit(ri);
+         throttled_ = !has_capacity();
+         released = true;
+      });
+
+      if (released)
+         notify_writer();
    }
 
    template <class CompletionToken, class Logger>
@@ -772,46 +1211,110 @@ private:
 
    [[nodiscard]] bool coalesce_requests()
    {
-      // Coalesces the requests and marks them staged. After a
-      // successful write staged requests will be marked as written.
-      auto const point = std::partition_point(std::cbegin(reqs_), std::cend(reqs_), [](auto const& ri) {
-            return !ri->is_waiting();
+      // Stages the waiting requests. After a successful write staged
+      // requests will be marked as written.
+      if (reqs_.waiting.empty())
+         return false;
+
+      // Requests are staged in order until the batch is full, the
+      // rest is written by the next write operation. The first
+      // request is always staged, even if larger than the batch.
+      auto const max_batch = runner_.get_config().max_batch_bytes;
+      request_queue::list_type staged;
+      std::size_t batch = 0;
+      bool full = false;
+      reqs_.waiting.for_each([&](req_info& ri) {
+         full = full || (max_batch != 0 && batch != 0 && batch + ri.size_ > max_batch);
+         if (full)
+            return;
+
+         batch += ri.size_;
+         request_queue::list_type::unlink(ri);
+         ri.mark_staged();
+         staged.push_back(ri);
+         usage_.commands_sent += ri.expected_responses_;
+      });
+
+      // Small fragments are coalesced into write_buffer_ while large
+      // ones, e.g. arguments added with push_ref, are written directly
+      // from where they live with a gather write. Reserving upfront
+      // keeps the buffers that point into write_buffer_ valid while
+      // it is filled.
+      std::size_t to_copy = 0;
+      staged.for_each([&](req_info const& ri) {
+         ri.req_->for_each_fragment([&](std::string_view frag) {
+            if (std::size(frag) < max_coalesce_size)
+               to_copy += std::size(frag);
+         });
       });
 
-      std::for_each(point, std::cend(reqs_), [this](auto const& ri) {
-         // Stage the request.
-         write_buffer_ += ri->req_->payload();
-         ri->mark_staged();
-         usage_.commands_sent += ri->expected_responses_;
+      write_buffer_.reserve(to_copy);
+
+      bool coalescing = false;
+      auto add_fragment = [&](std::string_view frag) {
+         if (std::size(frag) < max_coalesce_size) {
+            if (coalescing) {
+               auto const& last = write_buffers_.back();
+               write_buffers_.back() = asio::const_buffer(last.data(), last.size() + std::size(frag));
+            } else {
+               write_buffers_.emplace_back(write_buffer_.data() + std::size(write_buffer_), std::size(frag));
+            }
+            write_buffer_ += frag;
+            coalescing = true;
+         } else {
+            write_buffers_.emplace_back(std::data(frag), std::size(frag));
+            coalescing = false;
+         }
+      };
+
+      staged.for_each([&](req_info const& ri) {
+         ri.req_->for_each_fragment(add_fragment);
       });
 
-      usage_.bytes_sent += std::size(write_buffer_);
+      reqs_.staged.splice_back(staged);
+
+      auto const size = asio::buffer_size(write_buffers_);
+      usage_.bytes_sent += size;
+      usage_.bytes_copied += std::size(write_buffer_);
+      usage_.writes += 1;
+      usage_.write_sizes[size_index(size)] += 1;
 
-      return point != std::cend(reqs_);
+      return true;
+   }
+
+   // Index of the element of usage::write_sizes and
+   // usage::read_sizes that counts operations of n bytes.
+   static auto size_index(std::size_t n) noexcept -> std::size_t
+   {
+      std::size_t i = 0;
+      while (i + 1 < std::size(usage{}.write_sizes) && n >= (std::size_t{64} << i))
+         ++i;
+
+      return i;
    }
 
    bool is_waiting_response() const noexcept
    {
-      if (std::empty(reqs_))
+      if (reqs_.empty())
          return false;
 
       // Under load and on low-latency networks we might start
       // receiving responses before the write operation completed and
       // the request is still maked as staged and not written.  See
       // https://github.com/boostorg/redis/issues/170
-      return !reqs_.front()->is_waiting();
+      return !reqs_.front().is_waiting();
    }
 
    void close()
    {
-      if (stream_->next_layer().is_open()) {
+      if (lowest_layer().is_open()) {
          system::error_code ec;
-         stream_->next_layer().close(ec);
+         lowest_layer().close(ec);
       }
    }
 
-   auto is_open() const noexcept { return stream_->next_layer().is_open(); }
-   auto& lowest_layer() noexcept { return stream_->lowest_layer(); }
+   auto is_open() const noexcept { return stream_.get().lowest_layer().is_open(); }
+   auto& lowest_layer() noexcept { return stream_.get().lowest_layer(); }
 
    auto is_next_push()
    {
@@ -824,7 +1327,7 @@ private:
       // - https://github.com/boostorg/redis/issues/170
 
       // The message's resp3 type is a push.
-      if (resp3::to_type(read_buffer_.front()) == resp3::type::push)
+      if (resp3::to_type(read_buffer_.view().front()) == resp3::type::push)
          return true;
 
       // This is non-push type and the requests queue is empty. I have
@@ -839,7 +1342,7 @@ private:
 
       // The request does not expect any response but we got one. This
       // may happen if for example, subscribe with wrong syntax.
-      if (reqs_.front()->expected_responses_ == 0)
+      if (reqs_.front().expected_responses_ == 0)
          return true;
 
       // Added to deal with MONITOR and also to fix PR170 which
@@ -847,32 +1350,91 @@ private:
       // might start receiving responses before the write operation
       // completed and the request is still maked as staged and not
       // written.
-      return reqs_.front()->is_waiting();
+      return reqs_.front().is_waiting();
    }
 
    auto get_suggested_buffer_growth() const noexcept
    {
-      return parser_.get_suggested_buffer_growth(4096);
+      return parser_.get_suggested_buffer_growth(read_size_.size());
+   }
+
+   [[nodiscard]] auto is_direct_read_pending() const noexcept
+   {
+      return direct_.data != nullptr
+          && read_buffer_.empty()
+          && parser_.get_bulk_remaining() != 0;
+   }
+
+   [[nodiscard]] auto get_direct_buffer() const noexcept
+   {
+      return asio::buffer(direct_.data + direct_.written, parser_.get_bulk_remaining());
+   }
+
+   // Called after n bytes of a bulk string have been read directly
+   // into the response.
+   void on_direct_read(std::size_t n)
+   {
+      usage_.reads += 1;
+      usage_.read_sizes[size_index(n)] += 1;
+      direct_.written += n;
+      discarded_ += n;
+      parser_.skip_bulk(n);
+   }
+
+   // Called after n bytes have been read into the buffer.
+   void on_append(std::size_t n)
+   {
+      usage_.reads += 1;
+      usage_.read_sizes[size_index(n)] += 1;
+      read_size_.on_read(n, runner_.get_config().max_read_growth);
    }
 
    enum class parse_result { needs_more, push, resp };
 
    using parse_ret_type = std::pair<parse_result, std::size_t>;
 
+   // Size of the message being parsed, including the chunks that
+   // have already been discarded.
+   [[nodiscard]] auto message_size() const noexcept
+      { return discarded_ + parser_.get_consumed(); }
+
+   // Chunks of bulk strings are removed from the read buffer as soon
+   // as they have been passed to the adapter, so that only about one
+   // chunk is kept in memory, see config::bulk_chunk_size.
+   void discard_chunks() noexcept
+   {
+      if (!parser_.is_chunking())
+         return;
+
+      discarded_ += parser_.get_consumed();
+      read_buffer_.consume(parser_.get_consumed());
+      parser_.discard_consumed();
+   }
+
    parse_ret_type on_finish_parsing(parse_result t)
    {
       if (t == parse_result::push) {
          usage_.pushes_received += 1;
-         usage_.push_bytes_received += parser_.get_consumed();
+         usage_.push_bytes_received += message_size();
       } else {
          usage_.responses_received += 1;
-         usage_.response_bytes_received += parser_.get_consumed();
+         usage_.response_bytes_received += message_size();
       }
 
+      auto const limit = 4 * runner_.get_config().max_read_growth;
+      auto const release = read_release_.on_message(message_size(), limit);
+
       on_push_ = false;
-      dbuf_.consume(parser_.get_consumed());
+      discarded_ = 0;
+      read_buffer_.consume(parser_.get_consumed());
+
+      // Memory taken by a large message is not kept for the life of
+      // the connection, see read_release_policy.
+      if (release)
+         read_buffer_.release_if_larger_than(limit);
+
       auto const res = std::make_pair(t, parser_.get_consumed());
-      parser_.reset();
+      parser_.reset_for_next_message();
       return res;
    }
 
@@ -888,11 +1450,16 @@ private:
       //    2. On a new message, in which case we have to determine
       //       whether the next messag is a push or a response.
       //
-      if (!on_push_) // Prepare for new message.
+      //    Once chunks of the message have been discarded the start
+      //    of the buffer is not the start of the message anymore,
+      //    only responses are received in chunks though.
+      //
+      if (!on_push_ && discarded_ == 0) // Prepare for new message.
          on_push_ = is_next_push();
 
       if (on_push_) {
-         if (!resp3::parse(parser_, data, receive_adapter_, ec))
+         parser_.set_bulk_chunk_size(0);
+         if (!receive_adapter_.parse(0, parser_, data, ec))
             return std::make_pair(parse_result::needs_more, 0);
 
          if (ec)
@@ -903,59 +1470,122 @@ private:
 
       BOOST_ASSERT_MSG(is_waiting_response(), "Not waiting for a response (using MONITOR command perhaps?)");
       BOOST_ASSERT(!reqs_.empty());
-      BOOST_ASSERT(reqs_.front() != nullptr);
-      BOOST_ASSERT(reqs_.front()->expected_responses_ != 0);
 
-      if (!resp3::parse(parser_, data, reqs_.front()->adapter_, ec))
+      auto& ri = reqs_.front();
+      BOOST_ASSERT(ri.expected_responses_ != 0);
+
+      // Responses are parsed by the adapter itself, see
+      // any_adapter::parse. Large bulk strings arrive in chunks if the
+      // response accepts them, it can then ask for the rest to be
+      // written to its own memory. The remaining chunks in the read
+      // buffer are copied there and the rest is read there directly,
+      // see reader_op.
+      auto adapter = [this, &ri](auto const& nd, system::error_code& ec2)
+      {
+         if (direct_.data != nullptr) {
+            if (std::empty(nd.value)) {
+               direct_ = {};
+            } else {
+               std::copy(std::cbegin(nd.value), std::cend(nd.value), direct_.data + direct_.written);
+               direct_.written += std::size(nd.value);
+            }
+            return;
+         }
+
+         ri.adapt(nd, ec2);
+      };
+
+      parser_.set_bulk_chunk_size(ri.supports_bulk_chunks() ? runner_.get_config().bulk_chunk_size : 0);
+      auto const done = direct_.data != nullptr
+         ? resp3::parse(parser_, data, adapter, ec)
+         : ri.parse(parser_, data, ec);
+
+      if (!done) {
+         if (parser_.is_chunking() && direct_.data == nullptr && parser_.get_bulk_remaining() != 0) {
+            direct_.data = ri.bulk_destination(parser_.get_bulk_remaining());
+            direct_.written = 0;
+         }
+
+         discard_chunks();
          return std::make_pair(parse_result::needs_more, 0);
+      }
 
       if (ec) {
-         reqs_.front()->ec_ = ec;
-         reqs_.front()->proceed();
+         ri.ec_ = ec;
+         ri.proceed();
          return std::make_pair(parse_result::resp, 0);
       }
 
-      reqs_.front()->read_size_ += parser_.get_consumed();
+      ri.read_size_ += message_size();
 
-      if (--reqs_.front()->expected_responses_ == 0) {
+      --reqs_.pending_responses;
+      if (--ri.expected_responses_ == 0) {
          // Done with this request.
-         reqs_.front()->proceed();
+         ri.proceed();
          reqs_.pop_front();
       }
 
+      release_blocked();
+
       return on_finish_parsing(parse_result::resp);
    }
 
    void reset()
    {
       write_buffer_.clear();
+      write_buffers_.clear();
       read_buffer_.clear();
       parser_.reset();
+      discarded_ = 0;
+      direct_ = {};
       on_push_ = false;
       cancel_run_called_ = false;
    }
 
-   asio::ssl::context ctx_;
-   std::unique_ptr<next_layer_type> stream_;
+   stream_holder_type stream_;
 
    // Notice we use a timer to simulate a condition-variable. It is
    // also more suitable than a channel and the notify operation does
    // not suspend.
    timer_type writer_timer_;
+
+   // Wakes the writer when config::write_coalesce_delay has elapsed.
+   timer_type cork_timer_;
    receive_channel_type receive_channel_;
    runner_type runner_;
-   receiver_adapter_type receive_adapter_;
+   any_adapter receive_adapter_;
 
-   using dyn_buffer_type = asio::dynamic_string_buffer<char, std::char_traits<char>, std::allocator<char>>;
+   // Payload fragments smaller than this are copied into
+   // write_buffer_, larger ones are written without copying.
+   static constexpr std::size_t max_coalesce_size = 4096;
 
-   std::string read_buffer_;
-   dyn_buffer_type dbuf_;
+   read_buffer read_buffer_;
+   read_size_policy read_size_;
+   read_release_policy read_release_;
    std::string write_buffer_;
-   reqs_type reqs_;
+   std::vector<asio::const_buffer> write_buffers_;
+   request_queue reqs_;
+   std::shared_ptr<req_info_pool> req_pool_ = std::make_shared<req_info_pool>();
    resp3::parser parser_{};
+
+   // Bytes of the current message discarded by discard_chunks or
+   // read directly into the response.
+   std::size_t discarded_ = 0;
+
+   // The bulk string being read into the response.
+   struct direct_bulk {
+      char* data = nullptr;
+      std::size_t written = 0;
+   };
+
+   direct_bulk direct_;
    bool on_push_ = false;
    bool cancel_run_called_ = false;
 
+   // Set when the limits in the config have been reached, until the
+   // queue drains below the low-water marks.
+   bool throttled_ = false;
+
    usage usage_;
 };
 
@@ -14,25 +14,30 @@
 #include <boost/asio/coroutine.hpp>
 #include <boost/asio/experimental/parallel_group.hpp>
 #include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
 #include <boost/asio/steady_timer.hpp>
+#include <array>
 #include <string>
 #include <chrono>
+#include <type_traits>
 
 namespace boost::redis::detail
 {
 
-template <class Connector, class Stream>
+template <class Connector, class Stream, class EndpointSequence>
 struct connect_op {
+   using endpoint_type = typename Stream::endpoint_type;
+
    Connector* ctor_ = nullptr;
    Stream* stream = nullptr;
-   asio::ip::tcp::resolver::results_type const* res_ = nullptr;
+   EndpointSequence endpoints_;
    asio::coroutine coro{};
 
    template <class Self>
    void operator()( Self& self
                   , std::array<std::size_t, 2> const& order = {}
                   , system::error_code const& ec1 = {}
-                  , asio::ip::tcp::endpoint const& ep= {}
+                  , endpoint_type const& ep= {}
                   , system::error_code const& ec2 = {})
    {
       BOOST_ASIO_CORO_REENTER (coro)
@@ -44,7 +49,7 @@ struct connect_op {
             [this](auto token)
             {
                auto f = [](system::error_code const&, auto const&) { return true; };
-               return asio::async_connect(*stream, *res_, f, token);
+               return asio::async_connect(*stream, endpoints_, f, token);
             },
             [this](auto token) { return ctor_->timer_.async_wait(token);}
          ).async_wait(
@@ -58,7 +63,8 @@ struct connect_op {
 
          switch (order[0]) {
             case 0: {
-               ctor_->endpoint_ = ep;
+               if constexpr (std::is_same_v<endpoint_type, asio::ip::tcp::endpoint>)
+                  ctor_->endpoint_ = ep;
                self.complete(ec1);
             } break;
             case 1:
@@ -99,11 +105,31 @@ public:
          asio::ip::tcp::resolver::results_type const& res,
          CompletionToken&& token)
    {
+      using results_type = asio::ip::tcp::resolver::results_type;
+
+      return asio::async_compose
+         < CompletionToken
+         , void(system::error_code)
+         >(connect_op<connector, Stream, results_type>{this, &stream, res}, token, timer_);
+   }
+
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+   // Connects to a Unix domain socket.
+   template <class Stream, class CompletionToken>
+   auto
+   async_connect(
+         Stream& stream,
+         asio::local::stream_protocol::endpoint const& ep,
+         CompletionToken&& token)
+   {
+      using endpoints_type = std::array<asio::local::stream_protocol::endpoint, 1>;
+
       return asio::async_compose
          < CompletionToken
          , void(system::error_code)
-         >(connect_op<connector, Stream>{this, &stream, &res}, token, timer_);
+         >(connect_op<connector, Stream, endpoints_type>{this, &stream, {ep}}, token, timer_);
    }
+#endif // BOOST_ASIO_HAS_LOCAL_SOCKETS
 
    std::size_t cancel(operation op)
    {
@@ -121,7 +147,7 @@ public:
    auto const& endpoint() const noexcept { return endpoint_;}
 
 private:
-   template <class, class> friend struct connect_op;
+   template <class, class, class> friend struct connect_op;
 
    timer_type timer_;
    std::chrono::steady_clock::duration timeout_ = std::chrono::seconds{2};
@@ -0,0 +1,119 @@
+/* Copyright (c) 2018-2024 Marcelo Zimbres Silva (mzimbres@gmail.com)
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See
+ * accompanying file LICENSE.txt)
+ */
+
+#ifndef BOOST_REDIS_INTRUSIVE_LIST_HPP
+#define BOOST_REDIS_INTRUSIVE_LIST_HPP
+
+#include <boost/assert.hpp>
+
+namespace boost::redis::detail
+{
+
+// Base of the objects that can be linked in an intrusive_list.
+struct list_hook {
+   list_hook* prev_ = nullptr;
+   list_hook* next_ = nullptr;
+
+   [[nodiscard]] auto is_linked() const noexcept
+      { return next_ != nullptr; }
+};
+
+/* Doubly-linked list of objects deriving from list_hook.
+ *
+ * The list does not own its elements. Insertion, removal and moving
+ * all elements of a list to the end of another are O(1) and never
+ * allocate. An element can be unlinked without knowing the list it
+ * belongs to.
+ */
+template <class T>
+class intrusive_list {
+public:
+   intrusive_list() noexcept
+   {
+      head_.prev_ = &head_;
+      head_.next_ = &head_;
+   }
+
+   intrusive_list(intrusive_list const&) = delete;
+   intrusive_list& operator=(intrusive_list const&) = delete;
+
+   [[nodiscard]] auto empty() const noexcept
+      { return head_.next_ == &head_; }
+
+   [[nodiscard]] auto front() noexcept -> T&
+   {
+      BOOST_ASSERT(!empty());
+      return static_cast<T&>(*head_.next_);
+   }
+
+   [[nodiscard]] auto front() const noexcept -> T const&
+   {
+      BOOST_ASSERT(!empty());
+      return static_cast<T const&>(*head_.next_);
+   }
+
+   void push_back(T& t) noexcept
+      { link_before(&head_, &t); }
+
+   void push_front(T& t) noexcept
+      { link_before(head_.next_, &t); }
+
+   // Moves all elements of other to the end of this list.
+   void splice_back(intrusive_list& other) noexcept
+   {
+      if (other.empty())
+         return;
+
+      auto* first = other.head_.next_;
+      auto* last = other.head_.prev_;
+
+      first->prev_ = head_.prev_;
+      head_.prev_->next_ = first;
+      last->next_ = &head_;
+      head_.prev_ = last;
+
+      other.head_.prev_ = &other.head_;
+      other.head_.next_ = &other.head_;
+   }
+
+   // Calls f with each element in order, f may unlink the element it
+   // is called with.
+   template <class F>
+   void for_each(F f)
+   {
+      for (auto* p = head_.next_; p != &head_;) {
+         auto* next = p->next_;
+         f(static_cast<T&>(*p));
+         p = next;
+      }
+   }
+
+   static void unlink(T& t) noexcept
+   {
+      list_hook& h = t;
+      BOOST_ASSERT(h.is_linked());
+      h.prev_->next_ = h.next_;
+      h.next_->prev_ = h.prev_;
+      h.prev_ = nullptr;
+      h.next_ = nullptr;
+   }
+
+private:
+   static void link_before(list_hook* pos, list_hook* h) noexcept
+   {
+      BOOST_ASSERT(!h->is_linked());
+      h->prev_ = pos->prev_;
+      h->next_ = pos;
+      pos->prev_->next_ = h;
+      pos->prev_ = h;
+   }
+
+   list_hook head_;
+};
+
+} // boost::redis::detail
+
+#endif // BOOST_REDIS_INTRUSIVE_LIST_HPP
@@ -0,0 +1,141 @@
+/* Copyright (c) 2018-2024 Marcelo Zimbres Silva (mzimbres@gmail.com)
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See
+ * accompanying file LICENSE.txt)
+ */
+
+#ifndef BOOST_REDIS_READ_BUFFER_HPP
+#define BOOST_REDIS_READ_BUFFER_HPP
+
+#include <boost/asio/buffer.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <string>
+#include <string_view>
+
+namespace boost::redis::detail
+{
+
+/* Buffer where the connection reads data into.
+ *
+ * Consuming data from the front only advances an offset instead of
+ * erasing it, so that parsing a burst of pipelined messages from a
+ * single read costs constant work per message. The consumed bytes
+ * are reclaimed lazily in grow, when there is not enough room at the
+ * end or when they outweigh the unconsumed data.
+ *
+ * Provides the subset of the DynamicBuffer_v2 requirements used by
+ * async_append_some.
+ */
+class read_buffer {
+public:
+   explicit read_buffer(std::size_t max_size = (std::numeric_limits<std::size_t>::max)()) noexcept
+   : max_size_{max_size}
+   { }
+
+   /// Returns the number of unconsumed bytes.
+   [[nodiscard]] auto size() const noexcept -> std::size_t
+      { return buffer_.size() - offset_; }
+
+   [[nodiscard]] auto empty() const noexcept -> bool
+      { return size() == 0; }
+
+   [[nodiscard]] auto max_size() const noexcept -> std::size_t
+      { return max_size_; }
+
+   [[nodiscard]] auto capacity() const noexcept -> std::size_t
+      { return buffer_.capacity(); }
+
+   /// Returns the unconsumed bytes.
+   [[nodiscard]] auto view() const noexcept -> std::string_view
+      { return {buffer_.data() + offset_, size()}; }
+
+   /// Returns a buffer to n bytes starting at pos.
+   auto data(std::size_t pos, std::size_t n) noexcept -> asio::mutable_buffer;
+
+   /// Appends n bytes to the end of the buffer.
+   void grow(std::size_t n);
+
+   /// Removes n bytes from the end of the buffer.
+   void shrink(std::size_t n) noexcept;
+
+   /// Removes n bytes from the front of the buffer.
+   void consume(std::size_t n) noexcept;
+
+   /// Removes all bytes preserving allocated memory.
+   void clear() noexcept;
+
+   /// Releases all memory if the buffer is empty and its capacity
+   /// exceeds n, returns whether it was released.
+   auto release_if_larger_than(std::size_t n) noexcept -> bool;
+
+private:
+   void compact() noexcept;
+
+   std::string buffer_;
+
+   // Number of bytes consumed from the front of buffer_.
+   std::size_t offset_ = 0;
+   std::size_t max_size_;
+};
+
+/* Number of bytes the read buffer grows by before each read.
+ *
+ * Reads that fill all the space offered to them suggest more data is
+ * waiting in the socket, the size is then doubled up to a maximum so
+ * that bursts of small messages need fewer reads. Reads that use less
+ * than a quarter of it halve the size again.
+ */
+class read_size_policy {
+public:
+   static constexpr std::size_t min_size = 4096;
+
+   [[nodiscard]] auto size() const noexcept -> std::size_t
+      { return size_; }
+
+   void on_read(std::size_t n, std::size_t max_size) noexcept
+   {
+      if (n >= size_)
+         size_ *= 2;
+      else if (n < size_ / 4)
+         size_ /= 2;
+
+      size_ = (std::min)(size_, max_size);
+      size_ = (std::max)(size_, min_size);
+   }
+
+private:
+   std::size_t size_ = min_size;
+};
+
+/* Decides when the memory of the read buffer is released.
+ *
+ * Only after a number of consecutive messages that all fit in the
+ * limit, so that memory taken by a one-off large message is given
+ * back while workloads that keep receiving large messages don't
+ * free and reallocate the buffer for each of them.
+ */
+class read_release_policy {
+public:
+   static constexpr std::size_t small_messages = 16;
+
+   // Returns true if the buffer can be released.
+   auto on_message(std::size_t size, std::size_t limit) noexcept -> bool
+   {
+      if (size > limit)
+         small_ = 0;
+      else if (small_ < small_messages)
+         ++small_;
+
+      return small_ == small_messages;
+   }
+
+private:
+   std::size_t small_ = 0;
+};
+
+} // boost::redis::detail
+
+#endif // BOOST_REDIS_READ_BUFFER_HPP
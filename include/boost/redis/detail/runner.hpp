@@ -22,7 +22,9 @@
 #include <boost/asio/coroutine.hpp>
 #include <boost/asio/experimental/parallel_group.hpp>
 #include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
 #include <boost/asio/steady_timer.hpp>
+#include <boost/assert.hpp>
 #include <string>
 #include <memory>
 #include <chrono>
@@ -32,6 +34,23 @@ namespace boost::redis::detail
 
 void push_hello(config const& cfg, request& req);
 
+// Checked before the endpoint is built, its constructor throws on
+// paths that don't fit in sockaddr_un.
+inline auto check_unix_socket(std::string const& path) noexcept -> system::error_code
+{
+   if (path.empty())
+      return error::unix_socket_not_set;
+
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+   if (path.size() >= sizeof(asio::detail::sockaddr_un_type{}.sun_path))
+      return error::unix_socket_path_too_long;
+
+   return {};
+#else
+   return error::unix_sockets_unsupported;
+#endif // BOOST_ASIO_HAS_LOCAL_SOCKETS
+}
+
 template <class Runner, class Connection, class Logger>
 struct hello_op {
    Runner* runner_ = nullptr;
@@ -135,19 +154,38 @@ struct run_all_op {
    {
       BOOST_ASIO_CORO_REENTER (coro_)
       {
-         BOOST_ASIO_CORO_YIELD
-         runner_->resv_.async_resolve(std::move(self));
-         logger_.on_resolve(ec, runner_->resv_.results());
-         BOOST_REDIS_CHECK_OP0(conn_->cancel(operation::run);)
+         if (Connection::has_local_stream) {
+            ec = check_unix_socket(runner_->cfg_.unix_socket);
+            if (ec) {
+               self.complete(ec);
+               return;
+            }
+
+            // There is nothing to resolve.
+            BOOST_ASIO_CORO_YIELD
+            async_connect(std::move(self));
+            logger_.on_connect(ec, runner_->cfg_.unix_socket);
+            BOOST_REDIS_CHECK_OP0(conn_->cancel(operation::run);)
+         } else {
+            if (!runner_->cfg_.unix_socket.empty()) {
+               self.complete(error::unix_sockets_unsupported);
+               return;
+            }
 
-         BOOST_ASIO_CORO_YIELD
-         runner_->ctor_.async_connect(conn_->next_layer().next_layer(), runner_->resv_.results(), std::move(self));
-         logger_.on_connect(ec, runner_->ctor_.endpoint());
-         BOOST_REDIS_CHECK_OP0(conn_->cancel(operation::run);)
+            BOOST_ASIO_CORO_YIELD
+            runner_->resv_.async_resolve(std::move(self));
+            logger_.on_resolve(ec, runner_->resv_.results());
+            BOOST_REDIS_CHECK_OP0(conn_->cancel(operation::run);)
+
+            BOOST_ASIO_CORO_YIELD
+            async_connect(std::move(self));
+            logger_.on_connect(ec, runner_->ctor_.endpoint());
+            BOOST_REDIS_CHECK_OP0(conn_->cancel(operation::run);)
+         }
 
          if (conn_->use_ssl()) {
             BOOST_ASIO_CORO_YIELD
-            runner_->hsher_.async_handshake(conn_->next_layer(), std::move(self));
+            async_handshake(std::move(self));
             logger_.on_ssl_handshake(ec);
             BOOST_REDIS_CHECK_OP0(conn_->cancel(operation::run);)
          }
@@ -158,6 +196,35 @@ struct run_all_op {
          self.complete(ec);
       }
    }
+
+private:
+   template <class Self>
+   void async_connect(Self self)
+   {
+      if constexpr (Connection::has_local_stream) {
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+         asio::local::stream_protocol::endpoint const ep{runner_->cfg_.unix_socket};
+         runner_->ctor_.async_connect(conn_->lowest_layer(), ep, std::move(self));
+#else
+         // Not reached, see check_unix_socket.
+         self.complete(error::unix_sockets_unsupported);
+#endif // BOOST_ASIO_HAS_LOCAL_SOCKETS
+      } else {
+         runner_->ctor_.async_connect(conn_->lowest_layer(), runner_->resv_.results(), std::move(self));
+      }
+   }
+
+   // use_ssl() is always false on streams without an SSL layer.
+   template <class Self>
+   void async_handshake(Self self)
+   {
+      if constexpr (Connection::has_ssl_layer) {
+         runner_->hsher_.async_handshake(conn_->next_layer(), std::move(self));
+      } else {
+         BOOST_ASSERT(false);
+         self.complete(asio::error::operation_not_supported);
+      }
+   }
 };
 
 template <class Executor>
@@ -0,0 +1,106 @@
+/* Copyright (c) 2018-2024 Marcelo Zimbres Silva (mzimbres@gmail.com)
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See
+ * accompanying file LICENSE.txt)
+ */
+
+#ifndef BOOST_REDIS_STREAM_HOLDER_HPP
+#define BOOST_REDIS_STREAM_HOLDER_HPP
+
+#include <boost/asio/basic_stream_socket.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
+#include <boost/asio/ssl/context.hpp>
+#include <boost/asio/ssl/stream.hpp>
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace boost::redis::detail
+{
+
+template <class Stream>
+struct is_ssl_stream : std::false_type {};
+
+template <class Stream>
+struct is_ssl_stream<asio::ssl::stream<Stream>> : std::true_type {};
+
+// True when the stream connects over a Unix domain socket.
+template <class Stream>
+struct is_local_stream : std::false_type {};
+
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+template <class Executor>
+struct is_local_stream<asio::basic_stream_socket<asio::local::stream_protocol, Executor>>
+   : std::true_type {};
+
+template <class Stream>
+struct is_local_stream<asio::ssl::stream<Stream>> : is_local_stream<Stream> {};
+#endif // BOOST_ASIO_HAS_LOCAL_SOCKETS
+
+// Rebinds a stream type to another executor.
+template <class Stream, class Executor>
+struct rebind_stream {
+   using type = typename Stream::template rebind_executor<Executor>::other;
+};
+
+template <class Stream, class Executor>
+struct rebind_stream<asio::ssl::stream<Stream>, Executor> {
+   using type = asio::ssl::stream<typename rebind_stream<Stream, Executor>::type>;
+};
+
+/* Owns the stream of a connection and recreates it on reconnection.
+ *
+ * Streams without an SSL layer are stored by value.
+ */
+template <class Stream>
+class stream_holder {
+public:
+   using stream_type = Stream;
+
+   template <class Executor>
+   explicit stream_holder(Executor ex)
+   : stream_{std::move(ex)}
+   { }
+
+   void reset()
+      { stream_ = stream_type{stream_.get_executor()}; }
+
+   auto& get() noexcept { return stream_; }
+   auto const& get() const noexcept { return stream_; }
+
+private:
+   stream_type stream_;
+};
+
+/* SSL streams keep the context they are created with and are not
+ * move assignable, they are stored on the heap.
+ */
+template <class Stream>
+class stream_holder<asio::ssl::stream<Stream>> {
+public:
+   using stream_type = asio::ssl::stream<Stream>;
+
+   template <class Executor>
+   stream_holder(Executor ex, asio::ssl::context ctx)
+   : ctx_{std::move(ctx)}
+   , stream_{std::make_unique<stream_type>(std::move(ex), ctx_)}
+   { }
+
+   void reset()
+      { stream_ = std::make_unique<stream_type>(stream_->get_executor(), ctx_); }
+
+   auto& get() noexcept { return *stream_; }
+   auto const& get() const noexcept { return *stream_; }
+
+   auto const& get_ssl_context() const noexcept
+      { return ctx_; }
+
+private:
+   asio::ssl::context ctx_;
+   std::unique_ptr<stream_type> stream_;
+};
+
+} // boost::redis::detail
+
+#endif // BOOST_REDIS_STREAM_HOLDER_HPP
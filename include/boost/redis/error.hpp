@@ -81,6 +81,15 @@ enum class error
 
    /// Incompatible node depth.
    incompatible_node_depth,
+
+   /// `config::unix_socket` is set but the stream is not a Unix domain socket.
+   unix_sockets_unsupported,
+
+   /// The stream is a Unix domain socket but `config::unix_socket` is empty.
+   unix_socket_not_set,
+
+   /// `config::unix_socket` is longer than a Unix domain socket path can be.
+   unix_socket_path_too_long,
 };
 
 /** \internal
@@ -44,6 +44,9 @@ struct error_category_impl : system::error_category {
 	 case error::ssl_handshake_timeout: return "SSL handshake timeout.";
 	 case error::sync_receive_push_failed: return "Can't receive server push synchronously without blocking.";
 	 case error::incompatible_node_depth: return "Incompatible node depth.";
+	 case error::unix_sockets_unsupported: return "The connection stream does not support Unix domain sockets.";
+	 case error::unix_socket_not_set: return "Unix domain socket path not set in the config.";
+	 case error::unix_socket_path_too_long: return "Unix domain socket path in the config is too long.";
 	 default: BOOST_ASSERT(false); return "Boost.Redis error.";
       }
    }
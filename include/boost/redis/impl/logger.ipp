@@ -61,6 +61,23 @@ void logger::on_connect(system::error_code const& ec, asio::ip::tcp::endpoint co
    std::clog << std::endl;
 }
 
+void logger::on_connect(system::error_code const& ec, std::string_view unix_socket)
+{
+   if (level_ < level::info)
+      return;
+
+   write_prefix();
+
+   std::clog << "run-all-op: connected to Unix socket ";
+
+   if (ec)
+      std::clog << ec.message();
+   else
+      std::clog << unix_socket;
+
+   std::clog << std::endl;
+}
+
 void logger::on_ssl_handshake(system::error_code const& ec)
 {
    if (level_ < level::info)
@@ -89,7 +106,7 @@ void logger::on_connection_lost(system::error_code const& ec)
 void
 logger::on_write(
    system::error_code const& ec,
-   std::string const& payload)
+   std::size_t n)
 {
    if (level_ < level::info)
       return;
@@ -99,11 +116,19 @@ logger::on_write(
    if (ec)
       std::clog << "writer-op: " << ec.message();
    else
-      std::clog << "writer-op: " << std::size(payload) << " bytes written.";
+      std::clog << "writer-op: " << n << " bytes written.";
 
    std::clog << std::endl;
 }
 
+void
+logger::on_write(
+   system::error_code const& ec,
+   std::string const& payload)
+{
+   on_write(ec, std::size(payload));
+}
+
 void logger::on_read(system::error_code const& ec, std::size_t n)
 {
    if (level_ < level::info)
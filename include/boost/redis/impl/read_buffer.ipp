@@ -0,0 +1,77 @@
+/* Copyright (c) 2018-2024 Marcelo Zimbres Silva (mzimbres@gmail.com)
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See
+ * accompanying file LICENSE.txt)
+ */
+
+#include <boost/redis/detail/read_buffer.hpp>
+#include <boost/assert.hpp>
+#include <boost/throw_exception.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace boost::redis::detail
+{
+
+auto read_buffer::data(std::size_t pos, std::size_t n) noexcept -> asio::mutable_buffer
+{
+   BOOST_ASSERT(pos <= size());
+   return asio::buffer(buffer_.data() + offset_ + pos, (std::min)(n, size() - pos));
+}
+
+void read_buffer::grow(std::size_t n)
+{
+   if (size() > max_size_ || max_size_ - size() < n)
+      BOOST_THROW_EXCEPTION(std::length_error{"read_buffer overflow"});
+
+   // Moving the unconsumed bytes to the front is worth it when it
+   // avoids a reallocation or when they are fewer than the bytes
+   // reclaimed, which bounds the amortized cost per consumed byte.
+   if (offset_ != 0) {
+      auto const room = buffer_.capacity() - buffer_.size();
+      if ((room < n && room + offset_ >= n) || offset_ >= size())
+         compact();
+   }
+
+   buffer_.resize(buffer_.size() + n);
+}
+
+void read_buffer::shrink(std::size_t n) noexcept
+{
+   buffer_.resize(buffer_.size() - (std::min)(n, size()));
+}
+
+void read_buffer::consume(std::size_t n) noexcept
+{
+   offset_ += (std::min)(n, size());
+
+   // Cheap and by far the most common case: everything that has been
+   // read was parsed.
+   if (offset_ == buffer_.size())
+      clear();
+}
+
+void read_buffer::clear() noexcept
+{
+   buffer_.clear();
+   offset_ = 0;
+}
+
+auto read_buffer::release_if_larger_than(std::size_t n) noexcept -> bool
+{
+   if (!empty() || buffer_.capacity() <= n)
+      return false;
+
+   std::string{}.swap(buffer_);
+   offset_ = 0;
+   return true;
+}
+
+void read_buffer::compact() noexcept
+{
+   buffer_.erase(0, offset_);
+   offset_ = 0;
+}
+
+} // boost::redis::detail
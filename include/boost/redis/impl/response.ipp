@@ -45,4 +45,15 @@ void consume_one(generic_response& r)
       throw system::system_error(ec);
 }
 
+void consume_one(queue_response& r)
+{
+   if (r.has_error())
+      return; // Nothing to consume.
+
+   if (r.value().empty())
+      return; // Nothing to consume.
+
+   r.value().pop();
+}
+
 } // boost::redis::resp3
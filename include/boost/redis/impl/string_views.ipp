@@ -0,0 +1,81 @@
+/* Copyright (c) 2018-2024 Marcelo Zimbres Silva (mzimbres@gmail.com)
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See
+ * accompanying file LICENSE.txt)
+ */
+
+#include <boost/redis/string_views.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace boost::redis
+{
+
+string_arena::string_arena(string_arena&& other) noexcept
+: blocks_{std::move(other.blocks_)}
+, next_{std::exchange(other.next_, nullptr)}
+, left_{std::exchange(other.left_, 0)}
+, size_{std::exchange(other.size_, 0)}
+, capacity_{std::exchange(other.capacity_, 0)}
+{
+   other.blocks_.clear();
+}
+
+string_arena& string_arena::operator=(string_arena&& other) noexcept
+{
+   if (this != &other) {
+      blocks_ = std::move(other.blocks_);
+      other.blocks_.clear();
+      next_ = std::exchange(other.next_, nullptr);
+      left_ = std::exchange(other.left_, 0);
+      size_ = std::exchange(other.size_, 0);
+      capacity_ = std::exchange(other.capacity_, 0);
+   }
+
+   return *this;
+}
+
+auto string_arena::store(std::string_view s) -> std::string_view
+{
+   if (std::empty(s))
+      return {};
+
+   // Blocks double in size so that the number of allocations is
+   // logarithmic in the bytes stored. A string never spans blocks.
+   if (std::size(s) > left_) {
+      auto const last = std::empty(blocks_) ? 0 : blocks_.back().size;
+      auto const n = (std::max)({min_block_size, 2 * last, std::size(s)});
+      blocks_.push_back({std::make_unique<char[]>(n), n});
+      capacity_ += n;
+      next_ = blocks_.back().data.get();
+      left_ = n;
+   }
+
+   std::memcpy(next_, s.data(), std::size(s));
+   std::string_view const ret{next_, std::size(s)};
+   next_ += std::size(s);
+   left_ -= std::size(s);
+   size_ += std::size(s);
+   return ret;
+}
+
+void string_arena::clear() noexcept
+{
+   size_ = 0;
+   if (std::empty(blocks_))
+      return;
+
+   // The last block is the largest.
+   if (std::size(blocks_) > 1) {
+      std::swap(blocks_.front(), blocks_.back());
+      blocks_.erase(std::begin(blocks_) + 1, std::end(blocks_));
+   }
+
+   capacity_ = blocks_.front().size;
+   next_ = blocks_.front().data.get();
+   left_ = capacity_;
+}
+
+} // boost::redis
@@ -10,6 +10,7 @@
 #include <boost/redis/response.hpp>
 #include <boost/asio/ip/tcp.hpp>
 #include <string>
+#include <string_view>
 
 namespace boost::system {class error_code;}
 
@@ -84,6 +85,14 @@ public:
     */
    void on_connect(system::error_code const& ec, asio::ip::tcp::endpoint const& ep);
 
+   /** @brief Called when the connect operation to a Unix domain socket completes.
+    *  @ingroup high-level-api
+    *
+    *  @param ec Error returned by the connect operation.
+    *  @param unix_socket Path of the socket.
+    */
+   void on_connect(system::error_code const& ec, std::string_view unix_socket);
+
    /** @brief Called when the ssl handshake operation completes.
     *  @ingroup high-level-api
     *
@@ -102,6 +111,18 @@ public:
     *  @ingroup high-level-api
     *
     *  @param ec Error code returned by the write operation.
+    *  @param n Number of bytes written.
+    */
+   void on_write(system::error_code const& ec, std::size_t n);
+
+   /** @brief Called when the write operation completes.
+    *  @ingroup high-level-api
+    *
+    *  Custom loggers that only provide this overload keep working,
+    *  the connection then copies the bytes written into a string
+    *  for them. Providing the overload above avoids that copy.
+    *
+    *  @param ec Error code returned by the write operation.
     *  @param payload The payload written to the socket.
     */
    void on_write(system::error_code const& ec, std::string const& payload);
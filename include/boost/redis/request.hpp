@@ -7,22 +7,24 @@
 #ifndef BOOST_REDIS_REQUEST_HPP
 #define BOOST_REDIS_REQUEST_HPP
 
+#include <boost/redis/command.hpp>
+#include <boost/redis/command_template.hpp>
 #include <boost/redis/resp3/type.hpp>
 #include <boost/redis/resp3/serialization.hpp>
 
 #include <string>
+#include <string_view>
 #include <tuple>
+#include <type_traits>
 #include <algorithm>
+#include <iterator>
+#include <vector>
 
 // NOTE: For some commands like hset it would be a good idea to assert
 // the value type is a pair.
 
 namespace boost::redis {
 
-namespace detail{
-auto has_response(std::string_view cmd) -> bool;
-}
-
 /** \brief Creates Redis requests.
  *  \ingroup high-level-api
  *  
@@ -41,7 +43,8 @@ auto has_response(std::string_view cmd) -> bool;
  *
  *  \remarks
  *
- *  Uses a std::string for internal storage.
+ *  Uses a std::string for internal storage, except for arguments
+ *  added with `push_ref`, that are only referenced.
  */
 class request {
 public:
@@ -92,8 +95,55 @@ public:
    [[nodiscard]] auto get_commands() const noexcept -> std::size_t
       { return commands_;};
 
-   [[nodiscard]] auto payload() const noexcept -> std::string_view
-      { return payload_;}
+   /** @brief Returns the serialized request.
+    *
+    *  If arguments have been added with `push_ref` the payload is
+    *  assembled on the first call and cached until the request is
+    *  modified, prefer `for_each_fragment` to avoid the copy.
+    */
+   [[nodiscard]] auto payload() const -> std::string_view
+   {
+      if (std::empty(refs_))
+         return payload_;
+
+      if (std::empty(materialized_)) {
+         materialized_.reserve(size());
+         for_each_fragment([this](std::string_view frag) { materialized_ += frag; });
+      }
+
+      return materialized_;
+   }
+
+   /// Returns the size of the serialized request.
+   [[nodiscard]] auto size() const noexcept -> std::size_t
+   {
+      auto ret = std::size(payload_);
+      for (auto const& r: refs_)
+         ret += std::size(r.data);
+      return ret;
+   }
+
+   /** @brief Calls `f` with each fragment of the payload in order.
+    *
+    *  Fragments are either owned by the request or the buffers
+    *  passed to `push_ref`, concatenated they are equal to
+    *  `payload()`.
+    */
+   template <class F>
+   void for_each_fragment(F f) const
+   {
+      std::string_view const owned{payload_};
+      std::size_t pos = 0;
+      for (auto const& r: refs_) {
+         if (r.offset != pos)
+            f(owned.substr(pos, r.offset - pos));
+         f(r.data);
+         pos = r.offset;
+      }
+
+      if (pos != std::size(owned))
+         f(owned.substr(pos));
+   }
 
    [[nodiscard]] auto has_hello_priority() const noexcept -> auto const&
       { return has_hello_priority_;}
@@ -102,6 +152,8 @@ public:
    void clear()
    {
       payload_.clear();
+      refs_.clear();
+      materialized_.clear();
       commands_ = 0;
       expected_responses_ = 0;
       has_hello_priority_ = false;
@@ -145,6 +197,8 @@ public:
    template <class... Ts>
    void push(std::string_view cmd, Ts const&... args)
    {
+      reserve_more(serialized_size_hint(cmd, args...));
+
       auto constexpr pack_size = sizeof...(Ts);
       resp3::add_header(payload_, resp3::type::array, 1 + pack_size);
       resp3::add_bulk(payload_, cmd);
@@ -153,6 +207,98 @@ public:
       check_cmd(cmd);
    }
 
+   /** @brief Appends a new command from the catalog.
+    *
+    *  Like the overload above but the command properties are known
+    *  at compile time. For example
+    *
+    *  \code
+    *  request req;
+    *  req.push(cmd::set, "key", "value", "EX", 10);
+    *  req.push(cmd::ssubscribe, "channel");
+    *  \endcode
+    *
+    *  \param cmd A command e.g. `cmd::get`, see `boost::redis::cmd`.
+    *  \param args Command arguments.
+    */
+   template <class... Ts>
+   void push(command const& cmd, Ts const&... args)
+   {
+      reserve_more(serialized_size_hint(cmd.name, args...));
+
+      auto constexpr pack_size = sizeof...(Ts);
+      resp3::add_header(payload_, resp3::type::array, 1 + pack_size);
+      resp3::add_bulk(payload_, cmd.name);
+      resp3::add_bulk(payload_, std::tie(std::forward<Ts const&>(args)...));
+
+      add_command(cmd.responses, cmd.is_handshake());
+   }
+
+   /** @brief Appends a new command to the end of the request.
+    *
+    *  Like the overload above but the array header and the command
+    *  name are taken already serialized from `cmd`. For example
+    *
+    *  \code
+    *  constexpr command_template<2> incrby{"INCRBY"};
+    *
+    *  request req;
+    *  req.push(incrby, "key", 10);
+    *  \endcode
+    *
+    *  \param cmd The command template.
+    *  \param args Command arguments, there must be exactly `N`.
+    */
+   template <std::size_t N, class... Ts>
+   void push(command_template<N> const& cmd, Ts const&... args)
+   {
+      static_assert(sizeof...(Ts) == N,
+         "The number of arguments does not match the command template");
+
+      reserve_more(std::size(cmd.prefix()) + (std::size_t{0} + ... + resp3::bulk_size_hint<Ts>::size(args)));
+      payload_.append(cmd.prefix());
+      resp3::add_bulk(payload_, std::tie(std::forward<Ts const&>(args)...));
+
+      add_command(cmd.responses(), cmd.is_hello());
+   }
+
+   /** @brief Appends a new command whose arguments are not copied.
+    *
+    *  Like `push` but the arguments are referenced by the request
+    *  instead of being copied into it and are written to the socket
+    *  directly from the caller's memory. For example
+    *
+    *  \code
+    *  std::string blob = ...; // Possibly many megabytes.
+    *
+    *  request req;
+    *  req.push_ref("SET", "key", blob);
+    *  co_await conn->async_exec(req, ignore);
+    *  \endcode
+    *
+    *  The memory referred to by the arguments must remain valid and
+    *  unmodified until the request is cleared or destroyed and, in
+    *  particular, until `connection::async_exec` completes. Arguments
+    *  smaller than a few hundred bytes may be copied, as referencing
+    *  them would be more expensive.
+    *
+    *  \param cmd The command e.g redis or sentinel command.
+    *  \param args Command arguments, must be convertible to `std::string_view`.
+    */
+   template <class... Ts>
+   void push_ref(std::string_view cmd, Ts const&... args)
+   {
+      static_assert((std::is_convertible_v<Ts const&, std::string_view> && ...),
+         "push_ref arguments must be convertible to std::string_view");
+
+      auto constexpr pack_size = sizeof...(Ts);
+      resp3::add_header(payload_, resp3::type::array, 1 + pack_size);
+      resp3::add_bulk(payload_, cmd);
+      (add_bulk_ref(args), ...);
+
+      check_cmd(cmd);
+   }
+
    /** @brief Appends a new command to the end of the request.
     *  
     *  This overload is useful for commands that have a key and have a
@@ -200,6 +346,12 @@ public:
 
       auto constexpr size = resp3::bulk_counter<value_type>::size;
       auto const distance = std::distance(begin, end);
+      reserve_more(
+         resp3::header_size(2 + size * distance) +
+         resp3::bulk_size_hint<std::string_view>::size(cmd) +
+         resp3::bulk_size_hint<std::string_view>::size(key) +
+         range_size_hint(begin, end));
+
       resp3::add_header(payload_, resp3::type::array, 2 + size * distance);
       resp3::add_bulk(payload_, cmd);
       resp3::add_bulk(payload_, key);
@@ -252,6 +404,11 @@ public:
 
       auto constexpr size = resp3::bulk_counter<value_type>::size;
       auto const distance = std::distance(begin, end);
+      reserve_more(
+         resp3::header_size(1 + size * distance) +
+         resp3::bulk_size_hint<std::string_view>::size(cmd) +
+         range_size_hint(begin, end));
+
       resp3::add_header(payload_, resp3::type::array, 1 + size * distance);
       resp3::add_bulk(payload_, cmd);
 
@@ -305,20 +462,96 @@ public:
       push_range(cmd, cbegin(range), cend(range));
    }
 
+   /** @brief Returns the serialized size of a command.
+    *
+    *  The size `push(cmd, args...)` adds to the request, exact for
+    *  string arguments and an upper bound for numbers. Arguments
+    *  serialized by user-provided `boost_redis_to_bulk` overloads are
+    *  not accounted for. Useful to size buffers e.g.
+    *
+    *  \code
+    *  req.reserve(request::serialized_size_hint("SET", key, value));
+    *  \endcode
+    *
+    *  \param cmd The command e.g redis or sentinel command.
+    *  \param args Command arguments.
+    */
+   template <class... Ts>
+   [[nodiscard]] static auto serialized_size_hint(std::string_view cmd, Ts const&... args) noexcept -> std::size_t
+   {
+      return
+         resp3::header_size(1 + sizeof...(Ts)) +
+         resp3::bulk_size_hint<std::string_view>::size(cmd) +
+         (std::size_t{0} + ... + resp3::bulk_size_hint<Ts>::size(args));
+   }
+
 private:
+   // Referencing arguments smaller than this costs more than copying
+   // them.
+   static constexpr std::size_t min_ref_size = 256;
+
+   // A buffer owned by the user that is inserted at offset in
+   // payload_.
+   struct ref {
+      std::size_t offset;
+      std::string_view data;
+   };
+
+   // Reserves n more bytes, keeping the growth geometric so that many
+   // small pushes don't reallocate every time.
+   void reserve_more(std::size_t n)
+   {
+      auto const needed = std::size(payload_) + n;
+      if (needed > payload_.capacity())
+         payload_.reserve((std::max)(needed, 2 * payload_.capacity()));
+   }
+
+   // Sizing pass over the range, skipped when the size of the elements
+   // is not known.
+   template <class ForwardIterator>
+   static auto range_size_hint(ForwardIterator begin, ForwardIterator end) noexcept -> std::size_t
+   {
+      using value_type = typename std::iterator_traits<ForwardIterator>::value_type;
+      using hint_type = resp3::bulk_size_hint<value_type>;
+
+      std::size_t ret = 0;
+      if constexpr (hint_type::known) {
+         for (; begin != end; ++begin)
+            ret += hint_type::size(*begin);
+      }
+
+      return ret;
+   }
+
+   void add_bulk_ref(std::string_view data)
+   {
+      if (std::size(data) < min_ref_size) {
+         resp3::add_bulk(payload_, data);
+         return;
+      }
+
+      resp3::add_header(payload_, resp3::type::blob_string, std::size(data));
+      refs_.push_back({std::size(payload_), data});
+      resp3::add_separator(payload_);
+   }
+
    void check_cmd(std::string_view cmd)
+      { add_command(detail::has_response(cmd) ? 0 : 1, cmd == "HELLO"); }
+
+   void add_command(std::size_t responses, bool is_hello)
    {
+      materialized_.clear();
       ++commands_;
+      expected_responses_ += responses;
 
-      if (!detail::has_response(cmd))
-         ++expected_responses_;
-
-      if (cmd == "HELLO")
+      if (is_hello)
          has_hello_priority_ = cfg_.hello_with_priority;
    }
 
    config cfg_;
    std::string payload_;
+   std::vector<ref> refs_;
+   mutable std::string materialized_;
    std::size_t commands_ = 0;
    std::size_t expected_responses_ = 0;
    bool has_hello_priority_ = false;
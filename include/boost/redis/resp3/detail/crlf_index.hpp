@@ -0,0 +1,84 @@
+/* Copyright (c) 2018-2024 Marcelo Zimbres Silva (mzimbres@gmail.com)
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See
+ * accompanying file LICENSE.txt)
+ */
+
+#ifndef BOOST_REDIS_RESP3_DETAIL_CRLF_INDEX_HPP
+#define BOOST_REDIS_RESP3_DETAIL_CRLF_INDEX_HPP
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+namespace boost::redis::resp3::detail {
+
+// Implementations of the separator scan. The vectorized ones are
+// only available on the matching architectures, see
+// is_supported.
+enum class crlf_scanner
+{ automatic
+, scalar
+, sse2
+, avx2
+, neon
+};
+
+// Returns true if the scanner can run on this machine.
+auto is_supported(crlf_scanner s) noexcept -> bool;
+
+// Selects the scanner used by all parsers. The default,
+// crlf_scanner::automatic, picks the fastest one supported by the
+// CPU at runtime. Useful only in tests and benchmarks.
+void set_crlf_scanner(crlf_scanner s) noexcept;
+
+// Returns the scanner that is currently in use, never automatic.
+auto get_crlf_scanner() noexcept -> crlf_scanner;
+
+// Appends to out the position of every "\r\n" that starts in the
+// range [0, size - 1) of data. The positions are offset by base.
+void
+scan_crlf(
+   crlf_scanner s,
+   char const* data,
+   std::size_t size,
+   std::size_t base,
+   std::vector<std::size_t>& out);
+
+/* Index of the separators in the read buffer.
+ *
+ * Instead of searching for "\r\n" once for each element, the bytes
+ * appended to the buffer since the last scan are indexed in a single
+ * (vectorized) pass and the parser walks the index. Positions are
+ * stored relative to an origin so that discarding parsed messages
+ * from the front of the buffer (see shift) does not require
+ * rewriting them.
+ */
+class crlf_index {
+public:
+   // Returns the position in view of the first separator at or after
+   // pos or npos if more data is needed. Calls must be made with
+   // non-decreasing values of pos on views that share the same
+   // start. Throws std::bad_alloc if the index can't grow.
+   auto find(std::string_view view, std::size_t pos) -> std::size_t;
+
+   // Informs that n bytes have been discarded from the front of the
+   // buffer.
+   void shift(std::size_t n) noexcept;
+
+   // Drops all entries.
+   void clear() noexcept;
+
+private:
+   std::vector<std::size_t> positions_;
+   std::size_t head_ = 0;
+   std::size_t origin_ = 0;
+
+   // Number of bytes in the current view that have already been
+   // scanned.
+   std::size_t scanned_ = 0;
+};
+
+} // boost::redis::resp3::detail
+
+#endif // BOOST_REDIS_RESP3_DETAIL_CRLF_INDEX_HPP
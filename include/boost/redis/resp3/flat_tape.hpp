@@ -0,0 +1,216 @@
+/* Copyright (c) 2018-2024 Marcelo Zimbres Silva (mzimbres@gmail.com)
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See
+ * accompanying file LICENSE.txt)
+ */
+
+#ifndef BOOST_REDIS_RESP3_FLAT_TAPE_HPP
+#define BOOST_REDIS_RESP3_FLAT_TAPE_HPP
+
+#include <boost/redis/resp3/node.hpp>
+#include <boost/assert.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace boost::redis::resp3 {
+
+/** @brief Pre-order view of a response tree stored in flat form.
+ *  @ingroup high-level-api
+ *
+ *  Stores the same information as a `std::vector<resp3::node>` but
+ *  the values of all nodes are kept contiguously in a single buffer,
+ *  so that appending a node does not allocate. Calling `clear`
+ *  preserves the allocated memory for the next response.
+ *
+ *  Elements are returned by value as `basic_node<std::string_view>`
+ *  whose values point into the tape and therefore are invalidated by
+ *  calls to `push_back` and `clear`.
+ */
+class flat_tape {
+public:
+   /// The node type returned by the accessors.
+   using node_type = basic_node<std::string_view>;
+   using value_type = node_type;
+   using size_type = std::size_t;
+   using difference_type = std::ptrdiff_t;
+
+private:
+   struct entry {
+      type data_type;
+      std::size_t aggregate_size;
+      std::size_t depth;
+      std::size_t offset;
+      std::size_t size;
+   };
+
+public:
+   /// Random access iterator that yields nodes by value.
+   class const_iterator {
+   public:
+      using iterator_category = std::random_access_iterator_tag;
+      using value_type = node_type;
+      using difference_type = std::ptrdiff_t;
+      using reference = node_type;
+
+      struct pointer {
+         node_type node;
+         node_type const* operator->() const noexcept { return &node; }
+      };
+
+      const_iterator() = default;
+
+      reference operator*() const noexcept { return tape_->at_unchecked(i_); }
+      pointer operator->() const noexcept { return {**this}; }
+      reference operator[](difference_type n) const noexcept { return *(*this + n); }
+
+      const_iterator& operator++() noexcept { ++i_; return *this; }
+      const_iterator operator++(int) noexcept { auto tmp = *this; ++i_; return tmp; }
+      const_iterator& operator--() noexcept { --i_; return *this; }
+      const_iterator operator--(int) noexcept { auto tmp = *this; --i_; return tmp; }
+      const_iterator& operator+=(difference_type n) noexcept { i_ += n; return *this; }
+      const_iterator& operator-=(difference_type n) noexcept { i_ -= n; return *this; }
+
+      friend const_iterator operator+(const_iterator it, difference_type n) noexcept { return it += n; }
+      friend const_iterator operator+(difference_type n, const_iterator it) noexcept { return it += n; }
+      friend const_iterator operator-(const_iterator it, difference_type n) noexcept { return it -= n; }
+      friend difference_type operator-(const_iterator const& a, const_iterator const& b) noexcept
+         { return static_cast<difference_type>(a.i_) - static_cast<difference_type>(b.i_); }
+
+      friend bool operator==(const_iterator const& a, const_iterator const& b) noexcept { return a.i_ == b.i_; }
+      friend bool operator!=(const_iterator const& a, const_iterator const& b) noexcept { return a.i_ != b.i_; }
+      friend bool operator<(const_iterator const& a, const_iterator const& b) noexcept { return a.i_ < b.i_; }
+      friend bool operator>(const_iterator const& a, const_iterator const& b) noexcept { return a.i_ > b.i_; }
+      friend bool operator<=(const_iterator const& a, const_iterator const& b) noexcept { return a.i_ <= b.i_; }
+      friend bool operator>=(const_iterator const& a, const_iterator const& b) noexcept { return a.i_ >= b.i_; }
+
+   private:
+      friend class flat_tape;
+
+      const_iterator(flat_tape const* tape, std::size_t i) noexcept
+      : tape_{tape}, i_{i} {}
+
+      flat_tape const* tape_ = nullptr;
+      std::size_t i_ = 0;
+   };
+
+   using iterator = const_iterator;
+
+   /// Appends a node copying its value into the tape.
+   template <class String>
+   void push_back(basic_node<String> const& nd)
+   {
+      std::string_view const v{nd.value};
+      entries_.push_back({nd.data_type, nd.aggregate_size, nd.depth, data_.size(), v.size()});
+      data_.append(v.data(), v.size());
+   }
+
+   /// Returns the number of nodes.
+   [[nodiscard]] auto size() const noexcept -> std::size_t
+      { return entries_.size(); }
+
+   /// Returns true if there are no nodes.
+   [[nodiscard]] auto empty() const noexcept -> bool
+      { return entries_.empty(); }
+
+   /// Returns the i-th node in pre-order.
+   [[nodiscard]] auto operator[](std::size_t i) const noexcept -> node_type
+   {
+      BOOST_ASSERT(i < size());
+      return at_unchecked(i);
+   }
+
+   /// Returns the i-th node, throws `std::out_of_range` if i >= size().
+   [[nodiscard]] auto at(std::size_t i) const -> node_type
+   {
+      if (i >= size())
+         throw std::out_of_range{"flat_tape::at"};
+      return at_unchecked(i);
+   }
+
+   /// Returns the value of the i-th node.
+   [[nodiscard]] auto value(std::size_t i) const noexcept -> std::string_view
+      { return (*this)[i].value; }
+
+   [[nodiscard]] auto front() const noexcept -> node_type { return (*this)[0]; }
+   [[nodiscard]] auto back() const noexcept -> node_type { return (*this)[size() - 1]; }
+
+   [[nodiscard]] auto begin() const noexcept { return const_iterator{this, 0}; }
+   [[nodiscard]] auto end() const noexcept { return const_iterator{this, size()}; }
+   [[nodiscard]] auto cbegin() const noexcept { return begin(); }
+   [[nodiscard]] auto cend() const noexcept { return end(); }
+
+   /// Returns the buffer that stores the values of all nodes.
+   [[nodiscard]] auto get_data() const noexcept -> std::string_view
+      { return data_; }
+
+   /// Reserves memory for `nodes` nodes and `bytes` bytes of values.
+   void reserve(std::size_t nodes, std::size_t bytes)
+   {
+      entries_.reserve(nodes);
+      data_.reserve(bytes);
+   }
+
+   /// Removes all nodes preserving allocated memory.
+   void clear() noexcept
+   {
+      entries_.clear();
+      data_.clear();
+   }
+
+   /// Removes the first n nodes, linear in the number of remaining nodes.
+   void erase_front(std::size_t n)
+   {
+      BOOST_ASSERT(n <= size());
+      if (n == size()) {
+         clear();
+         return;
+      }
+
+      auto const bytes = entries_[n].offset;
+      entries_.erase(std::cbegin(entries_), std::cbegin(entries_) + n);
+      data_.erase(0, bytes);
+      for (auto& e: entries_)
+         e.offset -= bytes;
+   }
+
+private:
+   auto at_unchecked(std::size_t i) const noexcept -> node_type
+   {
+      auto const& e = entries_[i];
+      return {e.data_type, e.aggregate_size, e.depth, std::string_view{data_.data() + e.offset, e.size}};
+   }
+
+   std::vector<entry> entries_;
+   std::string data_;
+};
+
+/** @brief Compares two tapes for equality.
+ *  @relates flat_tape
+ */
+inline bool operator==(flat_tape const& a, flat_tape const& b) noexcept
+{
+   if (a.size() != b.size())
+      return false;
+
+   for (std::size_t i = 0; i < a.size(); ++i) {
+      if (!(a[i] == b[i]))
+         return false;
+   }
+
+   return true;
+}
+
+/** @brief Compares two tapes for difference.
+ *  @relates flat_tape
+ */
+inline bool operator!=(flat_tape const& a, flat_tape const& b) noexcept
+   { return !(a == b); }
+
+} // boost::redis::resp3
+
+#endif // BOOST_REDIS_RESP3_FLAT_TAPE_HPP
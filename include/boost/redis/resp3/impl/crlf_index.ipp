@@ -0,0 +1,296 @@
+/* Copyright (c) 2018-2024 Marcelo Zimbres Silva (mzimbres@gmail.com)
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See
+ * accompanying file LICENSE.txt)
+ */
+
+#include <boost/redis/resp3/detail/crlf_index.hpp>
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || (defined(__i386__) && defined(__SSE2__)) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  define BOOST_REDIS_CRLF_SSE2
+#  include <emmintrin.h>
+#  if defined(__GNUC__) || defined(__clang__)
+      // The AVX2 path is compiled with a target attribute and
+      // selected at runtime.
+#     define BOOST_REDIS_CRLF_AVX2
+#     define BOOST_REDIS_CRLF_AVX2_TARGET __attribute__((target("avx2")))
+#     include <immintrin.h>
+#  elif defined(__AVX2__)
+#     define BOOST_REDIS_CRLF_AVX2
+#     define BOOST_REDIS_CRLF_AVX2_TARGET
+#     include <immintrin.h>
+#  endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#  define BOOST_REDIS_CRLF_NEON
+#  include <arm_neon.h>
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#  include <intrin.h>
+#endif
+
+namespace boost::redis::resp3::detail {
+
+namespace {
+
+template <class T>
+auto countr_zero(T v) noexcept -> unsigned
+{
+   BOOST_ASSERT(v != 0);
+#if defined(_MSC_VER) && !defined(__clang__)
+   unsigned long i = 0;
+   if constexpr (sizeof(T) == 8) {
+      _BitScanForward64(&i, v);
+   } else {
+      _BitScanForward(&i, v);
+   }
+   return static_cast<unsigned>(i);
+#else
+   if constexpr (sizeof(T) == 8)
+      return static_cast<unsigned>(__builtin_ctzll(v));
+   else
+      return static_cast<unsigned>(__builtin_ctz(v));
+#endif
+}
+
+void
+scan_scalar(
+   char const* data,
+   std::size_t size,
+   std::size_t base,
+   std::vector<std::size_t>& out)
+{
+   if (size < 2)
+      return;
+
+   auto p = data;
+   auto const end = data + size - 1;
+   while (p < end) {
+      auto const r = static_cast<char const*>(std::memchr(p, '\r', static_cast<std::size_t>(end - p)));
+      if (r == nullptr)
+         return;
+
+      // r < end, so r[1] is still in range.
+      if (r[1] == '\n')
+         out.push_back(base + static_cast<std::size_t>(r - data));
+
+      p = r + 1;
+   }
+}
+
+#ifdef BOOST_REDIS_CRLF_SSE2
+void
+scan_sse2(
+   char const* data,
+   std::size_t size,
+   std::size_t base,
+   std::vector<std::size_t>& out)
+{
+   auto const cr = _mm_set1_epi8('\r');
+   auto const lf = _mm_set1_epi8('\n');
+
+   // Each block compares 16 bytes against '\r' and the same bytes
+   // shifted by one against '\n'.
+   std::size_t i = 0;
+   for (; i + 17 <= size; i += 16) {
+      auto const a = _mm_loadu_si128(reinterpret_cast<__m128i const*>(data + i));
+      auto const b = _mm_loadu_si128(reinterpret_cast<__m128i const*>(data + i + 1));
+      auto const m = _mm_and_si128(_mm_cmpeq_epi8(a, cr), _mm_cmpeq_epi8(b, lf));
+      auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(m));
+      for (; mask != 0; mask &= mask - 1)
+         out.push_back(base + i + countr_zero(mask));
+   }
+
+   scan_scalar(data + i, size - i, base + i, out);
+}
+#endif // BOOST_REDIS_CRLF_SSE2
+
+#ifdef BOOST_REDIS_CRLF_AVX2
+BOOST_REDIS_CRLF_AVX2_TARGET
+void
+scan_avx2(
+   char const* data,
+   std::size_t size,
+   std::size_t base,
+   std::vector<std::size_t>& out)
+{
+   auto const cr = _mm256_set1_epi8('\r');
+   auto const lf = _mm256_set1_epi8('\n');
+
+   std::size_t i = 0;
+   for (; i + 33 <= size; i += 32) {
+      auto const a = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(data + i));
+      auto const b = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(data + i + 1));
+      auto const m = _mm256_and_si256(_mm256_cmpeq_epi8(a, cr), _mm256_cmpeq_epi8(b, lf));
+      auto mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(m));
+      for (; mask != 0; mask &= mask - 1)
+         out.push_back(base + i + countr_zero(mask));
+   }
+
+   scan_scalar(data + i, size - i, base + i, out);
+}
+#endif // BOOST_REDIS_CRLF_AVX2
+
+#ifdef BOOST_REDIS_CRLF_NEON
+void
+scan_neon(
+   char const* data,
+   std::size_t size,
+   std::size_t base,
+   std::vector<std::size_t>& out)
+{
+   auto const cr = vdupq_n_u8('\r');
+   auto const lf = vdupq_n_u8('\n');
+   auto const ptr = reinterpret_cast<std::uint8_t const*>(data);
+
+   std::size_t i = 0;
+   for (; i + 17 <= size; i += 16) {
+      auto const a = vld1q_u8(ptr + i);
+      auto const b = vld1q_u8(ptr + i + 1);
+      auto const m = vandq_u8(vceqq_u8(a, cr), vceqq_u8(b, lf));
+
+      // There is no movemask on NEON, narrowing leaves one nibble per
+      // byte.
+      auto mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(m), 4)), 0);
+      while (mask != 0) {
+         auto const nibble = countr_zero(mask) / 4;
+         out.push_back(base + i + nibble);
+         mask &= ~(std::uint64_t{0xF} << (4 * nibble));
+      }
+   }
+
+   scan_scalar(data + i, size - i, base + i, out);
+}
+#endif // BOOST_REDIS_CRLF_NEON
+
+auto best_scanner() noexcept -> crlf_scanner
+{
+   if (is_supported(crlf_scanner::avx2))
+      return crlf_scanner::avx2;
+   if (is_supported(crlf_scanner::neon))
+      return crlf_scanner::neon;
+   if (is_supported(crlf_scanner::sse2))
+      return crlf_scanner::sse2;
+   return crlf_scanner::scalar;
+}
+
+std::atomic<crlf_scanner> selected_scanner{crlf_scanner::automatic};
+
+} // anonymous
+
+auto is_supported(crlf_scanner s) noexcept -> bool
+{
+   switch (s) {
+      case crlf_scanner::automatic:
+      case crlf_scanner::scalar: return true;
+#ifdef BOOST_REDIS_CRLF_SSE2
+      case crlf_scanner::sse2: return true;
+#endif
+#ifdef BOOST_REDIS_CRLF_AVX2
+      case crlf_scanner::avx2:
+#if defined(__GNUC__) || defined(__clang__)
+         return __builtin_cpu_supports("avx2");
+#else
+         return true;
+#endif
+#endif
+#ifdef BOOST_REDIS_CRLF_NEON
+      case crlf_scanner::neon: return true;
+#endif
+      default: return false;
+   }
+}
+
+void set_crlf_scanner(crlf_scanner s) noexcept
+{
+   BOOST_ASSERT_MSG(is_supported(s), "Scanner not supported on this machine.");
+   if (s == crlf_scanner::automatic)
+      s = best_scanner();
+   selected_scanner.store(s, std::memory_order_relaxed);
+}
+
+auto get_crlf_scanner() noexcept -> crlf_scanner
+{
+   auto s = selected_scanner.load(std::memory_order_relaxed);
+   if (s == crlf_scanner::automatic) {
+      s = best_scanner();
+      selected_scanner.store(s, std::memory_order_relaxed);
+   }
+
+   return s;
+}
+
+void
+scan_crlf(
+   crlf_scanner s,
+   char const* data,
+   std::size_t size,
+   std::size_t base,
+   std::vector<std::size_t>& out)
+{
+   switch (s) {
+#ifdef BOOST_REDIS_CRLF_SSE2
+      case crlf_scanner::sse2: scan_sse2(data, size, base, out); return;
+#endif
+#ifdef BOOST_REDIS_CRLF_AVX2
+      case crlf_scanner::avx2: scan_avx2(data, size, base, out); return;
+#endif
+#ifdef BOOST_REDIS_CRLF_NEON
+      case crlf_scanner::neon: scan_neon(data, size, base, out); return;
+#endif
+      case crlf_scanner::automatic: scan_crlf(get_crlf_scanner(), data, size, base, out); return;
+      default: scan_scalar(data, size, base, out);
+   }
+}
+
+auto crlf_index::find(std::string_view view, std::size_t pos) -> std::size_t
+{
+   for (;;) {
+      while (head_ < positions_.size() && positions_[head_] < origin_ + pos)
+         ++head_;
+
+      if (head_ < positions_.size())
+         return positions_[head_] - origin_;
+
+      // The index is exhausted, scans the bytes that haven't been seen
+      // yet. Bytes before pos belong to consumed elements e.g. bulk
+      // strings and don't have to be scanned.
+      auto const from = (std::max)(scanned_, pos);
+      if (from + 1 >= std::size(view))
+         return std::string_view::npos;
+
+      positions_.clear();
+      head_ = 0;
+      origin_ = 0;
+      scan_crlf(get_crlf_scanner(), view.data() + from, std::size(view) - from, from, positions_);
+
+      // The last byte is scanned again on the next call since the '\n'
+      // following it might not have been received yet.
+      scanned_ = std::size(view) - 1;
+
+      if (positions_.empty())
+         return std::string_view::npos;
+   }
+}
+
+void crlf_index::shift(std::size_t n) noexcept
+{
+   origin_ += n;
+   scanned_ = scanned_ > n ? scanned_ - n : 0;
+}
+
+void crlf_index::clear() noexcept
+{
+   positions_.clear();
+   head_ = 0;
+   origin_ = 0;
+   scanned_ = 0;
+}
+
+} // boost::redis::resp3::detail
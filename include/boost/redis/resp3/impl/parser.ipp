@@ -8,6 +8,7 @@
 #include <boost/redis/error.hpp>
 #include <boost/assert.hpp>
 
+#include <algorithm>
 #include <charconv>
 #include <limits>
 
@@ -26,21 +27,44 @@ parser::parser()
 }
 
 void parser::reset()
+{
+   reset_state();
+   crlf_.clear();
+}
+
+void parser::reset_for_next_message()
+{
+   crlf_.shift(consumed_);
+   reset_state();
+}
+
+void parser::reset_state() noexcept
 {
    depth_ = 0;
    sizes_ = {{1}};
    bulk_length_ = (std::numeric_limits<std::size_t>::max)();
    bulk_ = type::invalid;
    consumed_ = 0;
+   chunking_ = false;
    sizes_[0] = 2; // The sentinel must be more than 1.
 }
 
+void parser::discard_consumed() noexcept
+{
+   crlf_.shift(consumed_);
+   consumed_ = 0;
+}
+
 std::size_t
 parser::get_suggested_buffer_growth(std::size_t hint) const noexcept
 {
    if (!bulk_expected())
       return hint;
 
+   // No need to have more than one chunk in the buffer.
+   if (chunking_)
+      return (std::max)(hint, (std::min)(bulk_length_ + 2, chunk_size_));
+
    if (hint < bulk_length_ + 2)
       return bulk_length_ + 2;
 
@@ -70,12 +94,12 @@ parser::commit_elem() noexcept
 }
 
 auto
-parser::consume(std::string_view view, system::error_code& ec) noexcept -> parser::result
+parser::consume(std::string_view view, system::error_code& ec) -> parser::result
 {
    switch (bulk_) {
       case type::invalid:
       {
-         auto const pos = view.find(sep, consumed_);
+         auto const pos = crlf_.find(view, consumed_);
          if (pos == std::string::npos)
             return {}; // Needs more data to proceeed.
 
@@ -89,10 +113,20 @@ parser::consume(std::string_view view, system::error_code& ec) noexcept -> parse
          if (!bulk_expected())
             return ret;
 
+         // The header and the parts are one level deeper than the
+         // blob, as in streamed strings sent by the server.
+         if (chunk_size_ != 0 && bulk_ == type::blob_string && bulk_length_ > chunk_size_) {
+            chunking_ = true;
+            return node_type{type::streamed_string, 0, depth_ + 1, {}};
+         }
+
       } [[fallthrough]];
 
       default: // Handles bulk.
       {
+         if (chunking_)
+            return consume_chunk(view);
+
          auto const span = bulk_length_ + 2;
          if ((std::size(view) - consumed_) < span)
             return {}; // Needs more data to proceeed.
@@ -108,6 +142,34 @@ parser::consume(std::string_view view, system::error_code& ec) noexcept -> parse
    }
 }
 
+auto
+parser::consume_chunk(std::string_view view) noexcept -> parser::result
+{
+   auto const available = std::size(view) - consumed_;
+   auto const depth = depth_ + 1;
+
+   if (bulk_length_ == 0) {
+      // The separator that follows the data.
+      if (available < 2)
+         return {};
+
+      consumed_ += 2;
+      bulk_ = type::invalid;
+      chunking_ = false;
+      commit_elem();
+      return node_type{type::streamed_string_part, 1, depth, {}};
+   }
+
+   auto const n = (std::min)(available, bulk_length_);
+   if (n == 0)
+      return {};
+
+   node_type const ret = {type::streamed_string_part, 1, depth, view.substr(consumed_, n)};
+   consumed_ += n;
+   bulk_length_ -= n;
+   return ret;
+}
+
 auto
 parser::consume_impl(
    type t,
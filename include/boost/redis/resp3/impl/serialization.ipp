@@ -7,14 +7,25 @@
 #include <boost/redis/resp3/serialization.hpp>
 #include <boost/redis/resp3/parser.hpp>
 
+#include <charconv>
+
 namespace boost::redis::resp3 {
 
-void boost_redis_to_bulk(std::string& payload, std::string_view data)
+namespace {
+
+void add_size(std::string& payload, std::size_t size)
 {
-   auto const str = std::to_string(data.size());
+   char buf[24];
+   auto const res = std::to_chars(buf, buf + sizeof buf, size);
+   payload.append(buf, res.ptr);
+}
 
+} // anonymous
+
+void boost_redis_to_bulk(std::string& payload, std::string_view data)
+{
    payload += to_code(type::blob_string);
-   payload.append(std::cbegin(str), std::cend(str));
+   add_size(payload, data.size());
    payload += parser::sep;
    payload.append(std::cbegin(data), std::cend(data));
    payload += parser::sep;
@@ -22,10 +33,8 @@ void boost_redis_to_bulk(std::string& payload, std::string_view data)
 
 void add_header(std::string& payload, type t, std::size_t size)
 {
-   auto const str = std::to_string(size);
-
    payload += to_code(t);
-   payload.append(std::cbegin(str), std::cend(str));
+   add_size(payload, size);
    payload += parser::sep;
 }
 
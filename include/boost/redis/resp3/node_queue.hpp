@@ -0,0 +1,150 @@
+/* Copyright (c) 2018-2024 Marcelo Zimbres Silva (mzimbres@gmail.com)
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See
+ * accompanying file LICENSE.txt)
+ */
+
+#ifndef BOOST_REDIS_RESP3_NODE_QUEUE_HPP
+#define BOOST_REDIS_RESP3_NODE_QUEUE_HPP
+
+#include <boost/redis/resp3/flat_tape.hpp>
+#include <boost/assert.hpp>
+
+#include <cstddef>
+#include <vector>
+
+namespace boost::redis::resp3 {
+
+/** @brief A range of nodes.
+ *  @ingroup high-level-api
+ */
+class node_range {
+public:
+   using const_iterator = flat_tape::const_iterator;
+   using node_type = flat_tape::node_type;
+
+   node_range() = default;
+
+   node_range(const_iterator first, const_iterator last) noexcept
+   : first_{first}, last_{last} {}
+
+   [[nodiscard]] auto begin() const noexcept { return first_; }
+   [[nodiscard]] auto end() const noexcept { return last_; }
+
+   [[nodiscard]] auto size() const noexcept -> std::size_t
+      { return static_cast<std::size_t>(last_ - first_); }
+
+   [[nodiscard]] auto empty() const noexcept -> bool
+      { return first_ == last_; }
+
+   [[nodiscard]] auto operator[](std::size_t i) const noexcept -> node_type
+   {
+      BOOST_ASSERT(i < size());
+      return first_[static_cast<std::ptrdiff_t>(i)];
+   }
+
+private:
+   const_iterator first_;
+   const_iterator last_;
+};
+
+/** @brief A queue of messages in flat form.
+ *  @ingroup high-level-api
+ *
+ *  Nodes are appended to the back, e.g. by the connection while it
+ *  reads server pushes, and consumed one message at a time from the
+ *  front in constant time. A message starts at each node with depth
+ *  zero. Memory is reused once all messages have been popped.
+ *
+ *  Notice that, like `consume_one`, the message at the front is
+ *  delimited by the start of the next one, so it should only be
+ *  accessed after the connection has signaled it as complete e.g.
+ *  through `connection::async_receive`.
+ */
+class node_queue {
+public:
+   using node_type = flat_tape::node_type;
+
+   /// Appends a node.
+   template <class String>
+   void push_back(basic_node<String> const& nd)
+   {
+      if (nd.depth == 0)
+         starts_.push_back(tape_.size());
+
+      tape_.push_back(nd);
+   }
+
+   /// Returns the number of messages in the queue.
+   [[nodiscard]] auto size() const noexcept -> std::size_t
+      { return starts_.size() - head_; }
+
+   /// Returns true if there are no messages in the queue.
+   [[nodiscard]] auto empty() const noexcept -> bool
+      { return size() == 0; }
+
+   /// Returns the nodes of the message at the front.
+   [[nodiscard]] auto front() const noexcept -> node_range
+   {
+      BOOST_ASSERT(!empty());
+      auto const first = starts_[head_];
+      auto const last = head_ + 1 == starts_.size() ? tape_.size() : starts_[head_ + 1];
+      return {tape_.begin() + first, tape_.begin() + last};
+   }
+
+   /// Removes the message at the front in amortized constant time.
+   void pop()
+   {
+      BOOST_ASSERT(!empty());
+      ++head_;
+
+      if (head_ == starts_.size()) {
+         clear();
+         return;
+      }
+
+      // When the reader keeps the queue from draining, consumed
+      // messages are dropped once they outweigh the pending ones.
+      if (head_ >= starts_.size() - head_)
+         compact();
+   }
+
+   /// Removes all messages preserving allocated memory.
+   void clear() noexcept
+   {
+      tape_.clear();
+      starts_.clear();
+      head_ = 0;
+   }
+
+   /** @brief Returns the underlying tape.
+    *
+    *  Besides the messages in the queue, the tape may still hold
+    *  messages that have been popped but not dropped yet, these
+    *  come before `front()`. Use `front` and `pop` to visit only
+    *  the queued messages.
+    */
+   [[nodiscard]] auto get_tape() const noexcept -> flat_tape const&
+      { return tape_; }
+
+private:
+   void compact()
+   {
+      auto const n = starts_[head_];
+      tape_.erase_front(n);
+      starts_.erase(std::cbegin(starts_), std::cbegin(starts_) + static_cast<std::ptrdiff_t>(head_));
+      for (auto& s: starts_)
+         s -= n;
+      head_ = 0;
+   }
+
+   flat_tape tape_;
+
+   // Index in the tape where each message starts.
+   std::vector<std::size_t> starts_;
+   std::size_t head_ = 0;
+};
+
+} // boost::redis::resp3
+
+#endif // BOOST_REDIS_RESP3_NODE_QUEUE_HPP
@@ -8,11 +8,15 @@
 #define BOOST_REDIS_RESP3_PARSER_HPP
 
 #include <boost/redis/resp3/node.hpp>
+#include <boost/redis/resp3/detail/crlf_index.hpp>
 #include <boost/system/error_code.hpp>
+#include <boost/assert.hpp>
 #include <array>
 #include <string_view>
 #include <cstdint>
 #include <optional>
+#include <type_traits>
+#include <utility>
 
 namespace boost::redis::resp3 {
 
@@ -45,11 +49,25 @@ private:
    // The number of bytes consumed from the buffer.
    std::size_t consumed_;
 
+   // Position of the separators in the buffer.
+   detail::crlf_index crlf_;
+
+   // Blob strings larger than this are delivered in chunks, zero
+   // disables chunking.
+   std::size_t chunk_size_ = 0;
+
+   // True while the current bulk is delivered in chunks.
+   bool chunking_ = false;
+
    // Returns the number of bytes that have been consumed.
    auto consume_impl(type t, std::string_view elem, system::error_code& ec) -> node_type;
 
+   auto consume_chunk(std::string_view view) noexcept -> result;
+
    void commit_elem() noexcept;
 
+   void reset_state() noexcept;
+
    // The bulk type expected in the next read. If none is expected
    // returns type::invalid.
    [[nodiscard]]
@@ -67,14 +85,69 @@ public:
 
    auto get_consumed() const noexcept -> std::size_t;
 
-   auto consume(std::string_view view, system::error_code& ec) noexcept -> result;
+   // May throw std::bad_alloc, the separators in view are indexed in
+   // a buffer that grows, see detail::crlf_index.
+   auto consume(std::string_view view, system::error_code& ec) -> result;
 
    void reset();
+
+   /* Blob strings larger than n bytes are delivered as if they were
+    * streamed strings, i.e. a streamed_string node followed by
+    * streamed_string_part nodes with the data available and a last
+    * empty part. Zero, the default, disables it. Has effect from the
+    * next blob string on.
+    */
+   void set_bulk_chunk_size(std::size_t n) noexcept
+      { chunk_size_ = n; }
+
+   // Returns true while a blob string is delivered in chunks.
+   [[nodiscard]]
+   auto is_chunking() const noexcept -> bool
+      { return chunking_; }
+
+   // Number of bytes of the blob string being chunked that haven't
+   // been delivered yet.
+   [[nodiscard]]
+   auto get_bulk_remaining() const noexcept -> std::size_t
+      { return chunking_ ? bulk_length_ : 0; }
+
+   // Informs that n bytes of the blob string being chunked have been
+   // read by other means and must not be delivered.
+   void skip_bulk(std::size_t n) noexcept
+   {
+      BOOST_ASSERT(chunking_ && n <= bulk_length_);
+      bulk_length_ -= n;
+   }
+
+   // Forgets the bytes consumed so far, the caller is expected to
+   // have discarded them from the front of the buffer. Meant to be
+   // called while chunking, so that chunks don't accumulate in the
+   // buffer.
+   void discard_consumed() noexcept;
+
+   // Resets the parser for the next message in the same buffer. The
+   // caller is expected to have discarded get_consumed() bytes from
+   // the front of the buffer. Unlike reset, separators already found
+   // in the remaining bytes don't have to be searched again.
+   void reset_for_next_message();
 };
 
+namespace detail {
+
+template <class Adapter, class = void>
+struct has_on_raw : std::false_type {};
+
+template <class Adapter>
+struct has_on_raw<Adapter, std::void_t<decltype(std::declval<Adapter&>().on_raw(std::string_view{}))>>
+   : std::true_type {};
+
+} // detail
+
 // Returns false if more data is needed. If true is returned the
 // parser is either done or an error occured, that can be checked on
-// ec.
+// ec. Adapters that provide on_raw(std::string_view) are also passed
+// the bytes of the whole message once it is complete, msg is
+// therefore expected to start at the beginning of the message.
 template <class Adapter>
 bool
 parse(
@@ -94,6 +167,11 @@ parse(
       adapter(res.value(), ec);
       if (ec)
          return true;
+
+      if constexpr (detail::has_on_raw<Adapter>::value) {
+         if (p.done())
+            adapter.on_raw(msg.substr(0, p.get_consumed()));
+      }
    }
 
    return true;
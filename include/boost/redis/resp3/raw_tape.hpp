@@ -0,0 +1,103 @@
+/* Copyright (c) 2018-2024 Marcelo Zimbres Silva (mzimbres@gmail.com)
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See
+ * accompanying file LICENSE.txt)
+ */
+
+#ifndef BOOST_REDIS_RESP3_RAW_TAPE_HPP
+#define BOOST_REDIS_RESP3_RAW_TAPE_HPP
+
+#include <boost/redis/resp3/parser.hpp>
+#include <boost/system/error_code.hpp>
+#include <boost/system/system_error.hpp>
+#include <boost/throw_exception.hpp>
+#include <boost/assert.hpp>
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace boost::redis::resp3 {
+
+/** @brief The RESP3 wire bytes of a sequence of replies.
+ *  @ingroup high-level-api
+ *
+ *  Each reply is appended verbatim, as read from the socket, to a
+ *  single buffer, no nodes are built. The replies can be forwarded
+ *  as they are, either one by one or all at once with `get_data`,
+ *  and decoded on demand into any response type with `decode`.
+ *
+ *  The views returned by the accessors point into the tape and
+ *  therefore are invalidated by calls to `push_back` and `clear`.
+ */
+class raw_tape {
+public:
+   /// Appends the bytes of a complete reply.
+   void push_back(std::string_view reply)
+   {
+      data_.append(reply);
+      ends_.push_back(std::size(data_));
+   }
+
+   /// Returns the number of replies.
+   [[nodiscard]] auto size() const noexcept
+      { return std::size(ends_); }
+
+   /// Returns true if there are no replies.
+   [[nodiscard]] auto empty() const noexcept
+      { return std::empty(ends_); }
+
+   /// Returns the bytes of the i-th reply.
+   [[nodiscard]] auto operator[](std::size_t i) const noexcept -> std::string_view
+   {
+      BOOST_ASSERT(i < size());
+      auto const begin = i == 0 ? 0 : ends_[i - 1];
+      return std::string_view{data_}.substr(begin, ends_[i] - begin);
+   }
+
+   /// Returns the bytes of all replies in the order they were read.
+   [[nodiscard]] auto get_data() const noexcept -> std::string_view
+      { return data_; }
+
+   /// Removes all replies, keeping memory for reuse.
+   void clear() noexcept
+   {
+      data_.clear();
+      ends_.clear();
+   }
+
+   /** @brief Decodes the i-th reply.
+    *
+    *  @param i The index of the reply.
+    *  @param adapter The adapter of the target response e.g.
+    *  `adapter::adapt2(resp)`.
+    *  @param ec Set if the reply can't be decoded into the response.
+    */
+   template <class Adapter>
+   void decode(std::size_t i, Adapter adapter, system::error_code& ec) const
+   {
+      parser p;
+      auto const done = parse(p, (*this)[i], adapter, ec);
+      BOOST_ASSERT(done || ec);
+      (void)done;
+   }
+
+   /// Throwing overload of `decode`.
+   template <class Adapter>
+   void decode(std::size_t i, Adapter adapter) const
+   {
+      system::error_code ec;
+      decode(i, adapter, ec);
+      if (ec)
+         BOOST_THROW_EXCEPTION(system::system_error{ec});
+   }
+
+private:
+   std::string data_;
+   std::vector<std::size_t> ends_;
+};
+
+} // boost::redis::resp3
+
+#endif // BOOST_REDIS_RESP3_RAW_TAPE_HPP
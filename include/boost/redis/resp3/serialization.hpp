@@ -12,8 +12,13 @@
 #include <boost/throw_exception.hpp>
 #include <boost/redis/resp3/parser.hpp>
 
+#include <charconv>
+#include <cstdio>
+#include <limits>
 #include <string>
+#include <string_view>
 #include <tuple>
+#include <type_traits>
 
 // NOTE: Consider detecting tuples in the type in the parameter pack
 // to calculate the header size correctly.
@@ -41,11 +46,38 @@ namespace boost::redis::resp3 {
  */
 void boost_redis_to_bulk(std::string& payload, std::string_view data);
 
-template <class T, typename = typename std::enable_if<std::is_integral<T>::value>::type>
+/** @brief Adds a number to the request.
+ *  @relates boost::redis::request
+ *
+ *  Integers are formatted in decimal and floating-point numbers in
+ *  the shortest form that round-trips, without temporary strings.
+ *  `bool` is formatted as `1` or `0`.
+ *
+ *  @param payload Storage on which data will be copied into.
+ *  @param n Number.
+ */
+template <class T, typename = typename std::enable_if<std::is_arithmetic<T>::value>::type>
 void boost_redis_to_bulk(std::string& payload, T n)
 {
-   auto const s = std::to_string(n);
-   boost::redis::resp3::boost_redis_to_bulk(payload, std::string_view{s});
+   // Enough for 128-bit integers and the shortest form of long double.
+   char buf[64];
+   char* last = buf;
+
+   if constexpr (std::is_same<T, bool>::value) {
+      *last++ = n ? '1' : '0';
+   } else if constexpr (std::is_integral<T>::value) {
+      last = std::to_chars(buf, buf + sizeof buf, n).ptr;
+   } else {
+#if defined(_LIBCPP_VERSION) && _LIBCPP_VERSION < 14000
+      // No floating-point to_chars.
+      auto const size = std::snprintf(buf, sizeof buf, "%.*Lg", std::numeric_limits<T>::max_digits10, static_cast<long double>(n));
+      last = buf + size;
+#else
+      last = std::to_chars(buf, buf + sizeof buf, n).ptr;
+#endif
+   }
+
+   boost::redis::resp3::boost_redis_to_bulk(payload, std::string_view(buf, last - buf));
 }
 
 template <class T>
@@ -102,6 +134,70 @@ struct bulk_counter<std::pair<T, U>> {
   static constexpr auto size = 2U;
 };
 
+/// Returns the size of the header of an aggregate or bulk of the given size.
+constexpr auto header_size(std::size_t size) noexcept -> std::size_t
+{
+   std::size_t digits = 1;
+   for (; size >= 10; size /= 10)
+      ++digits;
+
+   // Type code, digits and separator.
+   return 1 + digits + 2;
+}
+
+/* Serialized size of the bulks of an argument.
+ *
+ * Exact for strings, an upper bound for numbers and zero, i.e.
+ * unknown, for types serialized by user-provided overloads of
+ * boost_redis_to_bulk.
+ */
+template <class T, class = void>
+struct bulk_size_hint {
+   static constexpr bool known = false;
+   static constexpr auto size(T const&) noexcept -> std::size_t { return 0; }
+};
+
+template <class T>
+struct bulk_size_hint<T, typename std::enable_if<std::is_convertible<T const&, std::string_view>::value>::type> {
+   static constexpr bool known = true;
+   static constexpr auto size(T const& t) noexcept -> std::size_t
+   {
+      auto const n = std::size(std::string_view{t});
+      return header_size(n) + n + 2;
+   }
+};
+
+template <class T>
+struct bulk_size_hint<T, typename std::enable_if<std::is_arithmetic<T>::value>::type> {
+   static constexpr bool known = true;
+   static constexpr auto size(T n) noexcept -> std::size_t
+   {
+      std::size_t chars = 1;
+      if constexpr (std::is_same<T, bool>::value) {
+         // 1 or 0.
+      } else if constexpr (std::is_integral<T>::value) {
+         if constexpr (std::is_signed<T>::value) {
+            if (n < 0)
+               ++chars;
+         }
+         for (; n / 10 != 0; n /= 10)
+            ++chars;
+      } else {
+         // Sign, digits, point and exponent of the longest shortest form.
+         chars = std::numeric_limits<T>::max_digits10 + 7;
+      }
+
+      return header_size(chars) + chars + 2;
+   }
+};
+
+template <class T, class U>
+struct bulk_size_hint<std::pair<T, U>> {
+   static constexpr bool known = bulk_size_hint<T>::known && bulk_size_hint<U>::known;
+   static constexpr auto size(std::pair<T, U> const& p) noexcept -> std::size_t
+      { return bulk_size_hint<T>::size(p.first) + bulk_size_hint<U>::size(p.second); }
+};
+
 void add_blob(std::string& payload, std::string_view blob);
 void add_separator(std::string& payload);
 
@@ -7,7 +7,11 @@
 #ifndef BOOST_REDIS_RESPONSE_HPP
 #define BOOST_REDIS_RESPONSE_HPP
 
+#include <boost/redis/bulk_sink.hpp>
 #include <boost/redis/resp3/node.hpp>
+#include <boost/redis/resp3/flat_tape.hpp>
+#include <boost/redis/resp3/node_queue.hpp>
+#include <boost/redis/resp3/raw_tape.hpp>
 #include <boost/redis/adapter/result.hpp>
 #include <boost/system.hpp>
 
@@ -34,6 +38,66 @@ using response = std::tuple<adapter::result<Ts>...>;
  */
 using generic_response = adapter::result<std::vector<resp3::node>>;
 
+/** @brief A generic response that stores all values in a single buffer
+ *  @ingroup high-level-api
+ *
+ *  Can be used wherever `generic_response` is used. Instead of one
+ *  `std::string` per node, the values are stored contiguously in a
+ *  `resp3::flat_tape`, which avoids one allocation per element in
+ *  large aggregates e.g. `HGETALL`. Clearing the tape preserves the
+ *  memory for the next response.
+ */
+using flat_response = adapter::result<resp3::flat_tape>;
+
+/** @brief A response whose messages can be consumed in constant time
+ *  @ingroup high-level-api
+ *
+ *  Meant to be passed to `connection::set_receive_response` when
+ *  server pushes arrive in bursts. The reader appends messages to
+ *  the back while the application consumes them from the front
+ *
+ * @code
+ * queue_response resp;
+ * conn->set_receive_response(resp);
+ *
+ * for (;;) {
+ *    co_await conn->async_receive(asio::deferred);
+ *    auto const msg = resp.value().front();
+ *    // Use the nodes in msg.
+ *    consume_one(resp);
+ * }
+ * @endcode
+ */
+using queue_response = adapter::result<resp3::node_queue>;
+
+/** @brief A response that keeps the RESP3 bytes of each reply
+ *  @ingroup high-level-api
+ *
+ *  Each reply is copied once, verbatim, into a `resp3::raw_tape`
+ *  without building nodes, which suits proxies that forward replies
+ *  as they were received. Error replies are stored like any other
+ *  reply instead of setting an error. Replies can be decoded later
+ *  on demand, for example
+ *
+ * @code
+ * request req;
+ * req.push("HGETALL", "hash");
+ *
+ * raw_response resp;
+ * co_await conn->async_exec(req, resp);
+ *
+ * co_await asio::async_write(downstream, asio::buffer(resp.value().get_data()));
+ *
+ * adapter::result<std::map<std::string, std::string>> fields;
+ * resp.value().decode(0, adapter::adapt2(fields));
+ * @endcode
+ *
+ *  The bytes of a reply are only available once it has been read
+ *  completely, `config::bulk_chunk_size` doesn't apply to this
+ *  response.
+ */
+using raw_response = adapter::result<resp3::raw_tape>;
+
 /** @brief Consume on response from a generic response
  *
  *  This function rotates the elements so that the start of the next
@@ -67,14 +131,20 @@ using generic_response = adapter::result<std::vector<resp3::node>>;
  * Given that this function rotates elements, it won't be very
  * efficient for responses with a large number of elements. It was
  * introduced mainly to deal with buffers server pushes as shown in
- * the cpp20_subscriber.cpp example. In the future queue-like
- * responses might be introduced to consume in O(1) operations. 
+ * the cpp20_subscriber.cpp example. To consume in O(1) operations
+ * use `queue_response`.
  */
 void consume_one(generic_response& r, system::error_code& ec);
 
 /// Throwing overload of `consume_one`.
 void consume_one(generic_response& r);
 
+/** @brief Consumes one message from a queue response in constant time
+ *
+ *  Does nothing if the response has an error or no messages.
+ */
+void consume_one(queue_response& r);
+
 } // boost::redis
 
 #endif // BOOST_REDIS_RESPONSE_HPP
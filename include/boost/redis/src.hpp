@@ -6,11 +6,13 @@
 
 #include <boost/redis/impl/error.ipp>
 #include <boost/redis/impl/logger.ipp>
-#include <boost/redis/impl/request.ipp>
 #include <boost/redis/impl/ignore.ipp>
 #include <boost/redis/impl/connection.ipp>
 #include <boost/redis/impl/response.ipp>
 #include <boost/redis/impl/runner.ipp>
+#include <boost/redis/impl/read_buffer.ipp>
+#include <boost/redis/impl/string_views.ipp>
 #include <boost/redis/resp3/impl/type.ipp>
 #include <boost/redis/resp3/impl/parser.ipp>
+#include <boost/redis/resp3/impl/crlf_index.ipp>
 #include <boost/redis/resp3/impl/serialization.ipp>
@@ -0,0 +1,143 @@
+/* Copyright (c) 2018-2024 Marcelo Zimbres Silva (mzimbres@gmail.com)
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See
+ * accompanying file LICENSE.txt)
+ */
+
+#ifndef BOOST_REDIS_STRING_VIEWS_HPP
+#define BOOST_REDIS_STRING_VIEWS_HPP
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace boost::redis
+{
+
+/** @brief Memory that strings are copied into one after the other.
+ *  @ingroup high-level-api
+ *
+ *  Memory is taken in blocks of growing size and never moved, so that
+ *  views of the stored strings remain valid until `clear` is called
+ *  or the arena is destroyed, including after the arena is moved.
+ */
+class string_arena {
+public:
+   /// Default constructor.
+   string_arena() = default;
+
+   /// Move constructor, views of the stored strings remain valid.
+   string_arena(string_arena&& other) noexcept;
+
+   /// Move assignment, views of the stored strings remain valid.
+   string_arena& operator=(string_arena&& other) noexcept;
+
+   string_arena(string_arena const&) = delete;
+   string_arena& operator=(string_arena const&) = delete;
+
+   /// Copies s into the arena and returns a view of the copy.
+   auto store(std::string_view s) -> std::string_view;
+
+   /// Invalidates all views, only the largest block is kept for reuse.
+   void clear() noexcept;
+
+   /// Returns the number of bytes stored.
+   [[nodiscard]] auto size() const noexcept
+      { return size_; }
+
+   /// Returns the number of bytes allocated.
+   [[nodiscard]] auto capacity() const noexcept
+      { return capacity_; }
+
+private:
+   static constexpr std::size_t min_block_size = 4096;
+
+   struct block {
+      std::unique_ptr<char[]> data;
+      std::size_t size = 0;
+   };
+
+   std::vector<block> blocks_;
+   char* next_ = nullptr;
+   std::size_t left_ = 0;
+   std::size_t size_ = 0;
+   std::size_t capacity_ = 0;
+};
+
+/** @brief A response of string views into memory it owns.
+ *  @ingroup high-level-api
+ *
+ *  Each value of the aggregate is copied once into an arena owned
+ *  by this object and a `std::string_view` of the copy is added to
+ *  the container. Compared to a container of `std::string`, that
+ *  makes a few growing allocations instead of one per element. The
+ *  views remain valid for the life of this object, also when it is
+ *  moved, for example
+ *
+ *  @code
+ *  request req;
+ *  req.push("LRANGE", "key", 0, -1);
+ *  req.push("HGETALL", "hash");
+ *
+ *  response<
+ *     string_views<>,
+ *     string_views<std::unordered_map<std::string_view, std::string_view>>
+ *  > resp;
+ *
+ *  co_await conn->async_exec(req, resp);
+ *
+ *  for (std::string_view v: std::get<0>(resp).value())
+ *     forward(v);
+ *  @endcode
+ *
+ *  @tparam Container A container of `std::string_view` that is a
+ *  sequence, set or map, see `adapter::container_category`.
+ */
+template <class Container = std::vector<std::string_view>>
+class string_views {
+public:
+   /// The container type.
+   using container_type = Container;
+
+   /// Returns the container of views.
+   [[nodiscard]] auto get() const noexcept -> Container const&
+      { return values_; }
+
+   /// Returns the container of views.
+   [[nodiscard]] auto get() noexcept -> Container&
+      { return values_; }
+
+   [[nodiscard]] auto begin() const noexcept { return std::cbegin(values_); }
+   [[nodiscard]] auto end() const noexcept { return std::cend(values_); }
+
+   /// Returns the number of elements in the container.
+   [[nodiscard]] auto size() const noexcept { return std::size(values_); }
+
+   /// Returns true if the container is empty.
+   [[nodiscard]] auto empty() const noexcept { return std::empty(values_); }
+
+   /// Copies s into the arena, see `string_arena::store`.
+   auto store(std::string_view s) -> std::string_view
+      { return arena_.store(s); }
+
+   /// Returns the arena the views point into.
+   [[nodiscard]] auto get_arena() const noexcept -> string_arena const&
+      { return arena_; }
+
+   /// Removes all elements, keeping memory for reuse.
+   void clear() noexcept
+   {
+      values_.clear();
+      arena_.clear();
+   }
+
+private:
+   Container values_;
+   string_arena arena_;
+};
+
+} // boost::redis
+
+#endif // BOOST_REDIS_STRING_VIEWS_HPP
@@ -7,6 +7,9 @@
 #ifndef BOOST_REDIS_USAGE_HPP
 #define BOOST_REDIS_USAGE_HPP
 
+#include <array>
+#include <cstddef>
+
 namespace boost::redis
 {
 
@@ -25,6 +28,39 @@ struct usage {
    /// Number of bytes sent.
    std::size_t bytes_sent = 0;
 
+   /** @brief Number of bytes copied before being sent.
+    *
+    *  Small payloads are coalesced into a single buffer before
+    *  writing, larger ones are written directly from the request
+    *  without being copied. The difference between `bytes_sent` and
+    *  this value is therefore the number of bytes that have been
+    *  sent without copying. Sample it periodically to obtain the
+    *  bytes copied per second.
+    */
+   std::size_t bytes_copied = 0;
+
+   /// Number of write operations.
+   std::size_t writes = 0;
+
+   /** @brief Distribution of the number of bytes per write.
+    *
+    *  Element `i` counts the writes of less than `64 << i` bytes that
+    *  are not counted by element `i - 1`, the last element counts the
+    *  writes of 1 MiB or more. Useful to tune
+    *  `config::write_coalesce_delay` and `config::max_batch_bytes`.
+    */
+   std::array<std::size_t, 16> write_sizes = {};
+
+   /// Number of read operations.
+   std::size_t reads = 0;
+
+   /** @brief Distribution of the number of bytes per read.
+    *
+    *  Buckets as in `write_sizes`. Useful to tune
+    *  `config::max_read_growth`.
+    */
+   std::array<std::size_t, 16> read_sizes = {};
+
    /// Number of responses received.
    std::size_t responses_received = 0;
 
@@ -48,6 +48,12 @@ std::string get_server_hostname()
    return safe_getenv("BOOST_REDIS_TEST_SERVER", "localhost");
 }
 
+// Path shared with the server in tools/docker-compose.yml.
+std::string get_server_unix_socket()
+{
+   return safe_getenv("BOOST_REDIS_TEST_UNIX_SOCKET", "/tmp/redis-socks/redis.sock");
+}
+
 boost::redis::config make_test_config()
 {
    boost::redis::config cfg;
@@ -17,6 +17,7 @@ auto start(boost::asio::awaitable<void> op) -> int;
 
 boost::redis::config make_test_config();
 std::string get_server_hostname();
+std::string get_server_unix_socket();
 
 void
 run(
@@ -0,0 +1,190 @@
+/* Copyright (c) 2018-2024 Marcelo Zimbres Silva (mzimbres@gmail.com)
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See
+ * accompanying file LICENSE.txt)
+ */
+
+#include <boost/redis/connection.hpp>
+#include <boost/asio/bind_cancellation_slot.hpp>
+#include <boost/asio/cancellation_signal.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/steady_timer.hpp>
+#define BOOST_TEST_MODULE conn-backpressure
+#include <boost/test/included/unit_test.hpp>
+#include "common.hpp"
+#include <iostream>
+#include <functional>
+#include <list>
+
+namespace net = boost::asio;
+using error_code = boost::system::error_code;
+using connection = boost::redis::connection;
+using boost::redis::request;
+using boost::redis::response;
+using boost::redis::ignore;
+using boost::redis::operation;
+using namespace std::chrono_literals;
+
+BOOST_AUTO_TEST_CASE(requests_are_held_back_and_executed_in_order)
+{
+   net::io_context ioc;
+   auto conn = std::make_shared<connection>(ioc);
+
+   auto cfg = make_test_config();
+   cfg.max_in_flight = 4;
+   cfg.max_queued_bytes = 64;
+   cfg.max_batch_bytes = 32;
+
+   std::size_t const n = 100;
+   std::list<request> reqs;
+   std::list<response<std::string>> resps;
+   std::size_t completed = 0;
+
+   for (std::size_t i = 0; i < n; ++i) {
+      auto& req = reqs.emplace_back();
+      req.push("PING", std::to_string(i));
+      auto& resp = resps.emplace_back();
+
+      conn->async_exec(req, resp, [&, i](error_code ec, std::size_t) {
+         BOOST_TEST(!ec);
+         BOOST_CHECK_EQUAL(std::get<0>(resp).value(), std::to_string(i));
+         BOOST_CHECK_EQUAL(completed, i);
+         if (++completed == n)
+            conn->cancel();
+      });
+   }
+
+   run(conn, cfg);
+   ioc.run_for(10s);
+
+   BOOST_CHECK_EQUAL(completed, n);
+}
+
+BOOST_AUTO_TEST_CASE(held_back_request_is_cancellable)
+{
+   net::io_context ioc;
+   auto conn = std::make_shared<connection>(ioc);
+
+   auto cfg = make_test_config();
+   cfg.health_check_interval = 0s;
+   cfg.max_in_flight = 1;
+
+   // Occupies the only slot for two seconds.
+   request req0;
+   req0.push("BLPOP", "any", 2);
+
+   bool req0_finished = false;
+   conn->async_exec(req0, ignore, [&](error_code ec, std::size_t) {
+      BOOST_TEST(!ec);
+      req0_finished = true;
+      conn->cancel();
+   });
+
+   request req1;
+   req1.push("PING");
+
+   net::cancellation_signal sig;
+   bool req1_finished = false;
+   conn->async_exec(req1, ignore, net::bind_cancellation_slot(sig.slot(), [&](error_code ec, std::size_t) {
+      BOOST_CHECK_EQUAL(ec, net::error::operation_aborted);
+      BOOST_TEST(!req0_finished);
+      req1_finished = true;
+   }));
+
+   net::steady_timer timer{ioc};
+   timer.expires_after(500ms);
+   timer.async_wait([&](error_code) {
+      sig.emit(net::cancellation_type::terminal);
+   });
+
+   run(conn, cfg);
+   ioc.run_for(10s);
+
+   BOOST_TEST(req1_finished);
+   BOOST_TEST(req0_finished);
+}
+
+BOOST_AUTO_TEST_CASE(coalesce_delay_batches_writes)
+{
+   net::io_context ioc;
+   auto conn = std::make_shared<connection>(ioc);
+
+   auto cfg = make_test_config();
+   cfg.health_check_interval = 0s;
+   cfg.write_coalesce_delay = 500ms;
+
+   request req0;
+   req0.push("PING");
+
+   // Each request is issued from a separate handler, so that the
+   // writer runs in between, but without waiting on a clock, so that
+   // all of them are issued within the delay.
+   std::size_t const n = 10;
+   request req;
+   req.push("PING");
+
+   std::size_t issued = 0;
+   std::size_t completed = 0;
+   std::size_t writes = 0;
+
+   std::function<void()> issue = [&]() {
+      conn->async_exec(req, ignore, [&](error_code ec, std::size_t) {
+         BOOST_TEST(!ec);
+         if (++completed == n) {
+            BOOST_CHECK_EQUAL(conn->get_usage().writes - writes, 1u);
+            conn->cancel();
+         }
+      });
+
+      if (++issued == n)
+         return;
+
+      net::post(ioc, [&]() { issue(); });
+   };
+
+   conn->async_exec(req0, ignore, [&](error_code ec, std::size_t) {
+      BOOST_TEST(!ec);
+      writes = conn->get_usage().writes;
+      issue();
+   });
+
+   run(conn, cfg);
+   ioc.run_for(10s);
+
+   BOOST_CHECK_EQUAL(completed, n);
+
+   auto const usage = conn->get_usage();
+   std::size_t total = 0;
+   for (auto w: usage.write_sizes)
+      total += w;
+   BOOST_CHECK_EQUAL(total, usage.writes);
+}
+
+BOOST_AUTO_TEST_CASE(coalesce_delay_skips_hello)
+{
+   net::io_context ioc;
+   auto conn = std::make_shared<connection>(ioc);
+
+   auto cfg = make_test_config();
+   cfg.health_check_interval = 0s;
+   cfg.write_coalesce_delay = 10s;
+
+   // Neither the setup request nor this one should wait for the
+   // delay.
+   request req;
+   req.push("HELLO", 3);
+
+   auto const start = std::chrono::steady_clock::now();
+   bool finished = false;
+   conn->async_exec(req, ignore, [&](error_code ec, std::size_t) {
+      BOOST_TEST(!ec);
+      BOOST_TEST((std::chrono::steady_clock::now() - start < 5s));
+      finished = true;
+      conn->cancel();
+   });
+
+   run(conn, cfg);
+   ioc.run_for(30s);
+
+   BOOST_TEST(finished);
+}
@@ -33,6 +33,7 @@ std::ostream& operator<<(std::ostream& os, usage const& u)
    os
       << "Commands sent: " << u.commands_sent << "\n"
       << "Bytes sent: " << u.bytes_sent << "\n"
+      << "Bytes copied: " << u.bytes_copied << "\n"
       << "Responses received: " << u.responses_received << "\n"
       << "Pushes received: " << u.pushes_received << "\n"
       << "Response bytes received: " << u.response_bytes_received << "\n"
@@ -22,6 +22,7 @@ using boost::redis::config;
 using boost::redis::connection;
 using boost::redis::generic_response;
 using boost::redis::ignore;
+using boost::redis::ignore_t;
 using boost::redis::operation;
 using boost::redis::request;
 using boost::redis::response;
@@ -188,3 +189,139 @@ BOOST_AUTO_TEST_CASE(large_number_of_concurrent_requests_issue_170)
    BOOST_CHECK_EQUAL(counter, repeat);
 }
 
+
+BOOST_AUTO_TEST_CASE(large_bulk_in_chunks)
+{
+   using boost::redis::bulk_sink;
+
+   std::string const value(1'000'000, 'x');
+
+   request req;
+   req.push("SET", "large-bulk-in-chunks", value);
+   req.push("GET", "large-bulk-in-chunks");
+
+   std::size_t received = 0;
+   std::size_t chunks = 0;
+   response<ignore_t, bulk_sink> resp{
+      ignore, bulk_sink{[&](std::size_t offset, std::string_view chunk, boost::system::error_code&) {
+         BOOST_CHECK_EQUAL(offset, received);
+         received += chunk.size();
+         ++chunks;
+      }}};
+
+   net::io_context ioc;
+   auto conn = std::make_shared<connection>(ioc);
+
+   auto cfg = make_test_config();
+   cfg.bulk_chunk_size = 4096;
+
+   conn->async_exec(req, resp, [&](auto ec, auto){
+      BOOST_TEST(!ec);
+      conn->cancel();
+   });
+
+   run(conn, cfg);
+   ioc.run();
+
+   BOOST_CHECK_EQUAL(received, value.size());
+   BOOST_TEST(chunks > 2u);
+}
+
+BOOST_AUTO_TEST_CASE(large_bulk_read_into_string)
+{
+   std::string value(10'000'000, 'x');
+   for (std::size_t i = 0; i < value.size(); i += 4096)
+      value[i] = static_cast<char>('a' + i % 26);
+
+   request req;
+   req.push("SET", "large-bulk-read-into-string", value);
+   req.push("GET", "large-bulk-read-into-string");
+
+   response<ignore_t, std::string> resp;
+
+   net::io_context ioc;
+   auto conn = std::make_shared<connection>(ioc);
+
+   conn->async_exec(req, resp, [&](auto ec, auto){
+      BOOST_TEST(!ec);
+      conn->cancel();
+   });
+
+   run(conn);
+   ioc.run();
+
+   BOOST_TEST(std::get<1>(resp).value() == value);
+
+   // The value did not go through the read buffer.
+   auto const usage = conn->get_usage();
+   BOOST_TEST(usage.reads < 100u);
+}
+
+// Replies that follow a bulk string read directly into the response,
+// in the same read, are parsed as usual.
+BOOST_AUTO_TEST_CASE(large_bulk_read_into_string_then_small_replies)
+{
+   std::string const value(1'000'000, 'y');
+
+   request req;
+   req.push("SET", "large-bulk-then-small", value);
+   req.push("GET", "large-bulk-then-small");
+   req.push("PING", "after");
+   req.push("GET", "large-bulk-then-small");
+
+   response<ignore_t, std::string, std::string, std::string> resp;
+
+   net::io_context ioc;
+   auto conn = std::make_shared<connection>(ioc);
+
+   auto cfg = make_test_config();
+   cfg.bulk_chunk_size = 4096;
+
+   conn->async_exec(req, resp, [&](auto ec, auto){
+      BOOST_TEST(!ec);
+      conn->cancel();
+   });
+
+   run(conn, cfg);
+   ioc.run();
+
+   BOOST_TEST(std::get<1>(resp).value() == value);
+   BOOST_CHECK_EQUAL(std::get<2>(resp).value(), "after");
+   BOOST_TEST(std::get<3>(resp).value() == value);
+}
+
+namespace {
+
+// A logger written against the overload of on_write that takes the
+// payload, it hides the overload that takes the size.
+struct payload_logger : boost::redis::logger {
+   std::shared_ptr<std::string> written = std::make_shared<std::string>();
+
+   void on_write(boost::system::error_code const&, std::string const& payload)
+      { *written += payload; }
+};
+
+} // anonymous
+
+BOOST_AUTO_TEST_CASE(logger_receives_payload)
+{
+   using tcp_connection = boost::redis::basic_tcp_connection<net::io_context::executor_type>;
+
+   request req;
+   req.push("PING", "logged-payload");
+
+   net::io_context ioc;
+   tcp_connection conn{ioc};
+
+   conn.async_exec(req, ignore, [&](auto ec, auto){
+      BOOST_TEST(!ec);
+      conn.cancel();
+   });
+
+   payload_logger l;
+   auto written = l.written;
+   conn.async_run(make_test_config(), l, [](auto){ });
+   ioc.run_for(std::chrono::seconds{10});
+
+   BOOST_TEST(written->find("logged-payload") != std::string::npos);
+}
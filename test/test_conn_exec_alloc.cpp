@@ -0,0 +1,107 @@
+/* Copyright (c) 2018-2024 Marcelo Zimbres Silva (mzimbres@gmail.com)
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See
+ * accompanying file LICENSE.txt)
+ */
+
+#include <boost/redis/connection.hpp>
+#include <boost/asio/detached.hpp>
+#define BOOST_TEST_MODULE conn-exec-alloc
+#include <boost/test/included/unit_test.hpp>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include "common.hpp"
+
+namespace net = boost::asio;
+using boost::redis::connection;
+using boost::redis::request;
+using boost::redis::response;
+using boost::system::error_code;
+
+namespace {
+
+// Counts the allocations made while counting is true.
+std::size_t allocations = 0;
+bool counting = false;
+
+} // anonymous
+
+void* operator new(std::size_t n)
+{
+   if (counting)
+      ++allocations;
+
+   if (auto* p = std::malloc(n == 0 ? 1 : n))
+      return p;
+
+   throw std::bad_alloc{};
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+// Executes the same request sequentially and counts allocations
+// after some warm-up executions.
+struct exec_loop {
+   connection* conn;
+   request const* req;
+   response<std::string>* resp;
+   int* remaining;
+   int warmup;
+
+   void operator()(error_code ec, std::size_t) const
+   {
+      if (ec) {
+         counting = false;
+         BOOST_TEST(!ec);
+         conn->cancel();
+         return;
+      }
+
+      if (--*remaining == 0) {
+         counting = false;
+         conn->cancel();
+         return;
+      }
+
+      if (*remaining == warmup)
+         counting = true;
+
+      conn->async_exec(*req, *resp, *this);
+   }
+};
+
+} // anonymous
+
+BOOST_AUTO_TEST_CASE(exec_allocations)
+{
+   net::io_context ioc;
+   auto conn = std::make_shared<connection>(ioc);
+
+   auto cfg = make_test_config();
+   cfg.health_check_interval = std::chrono::seconds{0};
+   conn->async_run(cfg, {}, net::detached);
+
+   request req;
+   req.push("PING");
+
+   // Fits in the small string buffer.
+   response<std::string> resp;
+
+   int const execs = 10000;
+   int remaining = 100 + execs;
+   conn->async_exec(req, resp, exec_loop{conn.get(), &req, &resp, &remaining, execs});
+
+   ioc.run();
+
+   std::cout << "Allocations per exec: " << static_cast<double>(allocations) / execs << std::endl;
+
+   BOOST_CHECK_EQUAL(remaining, 0);
+
+   // Leaves some room for Asio, that allocates operation state when
+   // its per-thread cache misses.
+   BOOST_TEST(allocations * 100 < static_cast<std::size_t>(execs));
+}
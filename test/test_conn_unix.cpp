@@ -0,0 +1,201 @@
+/* Copyright (c) 2018-2024 Marcelo Zimbres Silva (mzimbres@gmail.com)
+ *
+ * Distributed under the Boost Software License, Version 1.0. (See
+ * accompanying file LICENSE.txt)
+ */
+
+#include <boost/redis/connection.hpp>
+#include <boost/asio/steady_timer.hpp>
+#define BOOST_TEST_MODULE conn-unix
+#include <boost/test/included/unit_test.hpp>
+#include <filesystem>
+#include <iostream>
+#include "common.hpp"
+
+namespace net = boost::asio;
+namespace redis = boost::redis;
+
+using redis::request;
+using redis::response;
+using redis::error;
+using boost::system::error_code;
+using namespace std::chrono_literals;
+
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+
+using unix_connection = redis::basic_unix_connection<net::io_context::executor_type>;
+using tcp_connection = redis::basic_tcp_connection<net::io_context::executor_type>;
+
+namespace {
+
+auto make_unix_config()
+{
+   auto cfg = make_test_config();
+   cfg.unix_socket = get_server_unix_socket();
+   return cfg;
+}
+
+// Tests that talk to the server are skipped if it doesn't listen on
+// a Unix socket, see BOOST_REDIS_TEST_UNIX_SOCKET.
+auto server_has_unix_socket(boost::unit_test::test_unit_id) -> boost::test_tools::assertion_result
+{
+   std::error_code ec;
+   boost::test_tools::assertion_result ret{std::filesystem::exists(get_server_unix_socket(), ec)};
+   ret.message() << "No Unix socket at " << get_server_unix_socket();
+   return ret;
+}
+
+} // anonymous
+
+BOOST_AUTO_TEST_CASE(exec_over_unix_socket, *boost::unit_test::precondition(server_has_unix_socket))
+{
+   net::io_context ioc;
+   unix_connection conn{ioc};
+
+   request req;
+   req.push("HELLO", 3);
+   req.push("PING", "unix");
+   req.push("QUIT");
+
+   response<redis::ignore_t, std::string, std::string> resp;
+
+   bool exec_finished = false;
+   conn.async_exec(req, resp, [&](error_code ec, std::size_t) {
+      exec_finished = true;
+      BOOST_TEST(!ec);
+      conn.cancel(redis::operation::reconnection);
+   });
+
+   bool run_finished = false;
+   conn.async_run(make_unix_config(), {}, [&](error_code) {
+      run_finished = true;
+   });
+
+   ioc.run_for(10s);
+
+   BOOST_TEST(exec_finished);
+   BOOST_TEST(run_finished);
+   BOOST_CHECK_EQUAL(std::get<1>(resp).value(), "unix");
+}
+
+// QUIT makes the server close the connection, the requests that
+// follow must be sent on a new one. Later requests must be sent on
+// that same connection, i.e. health checks must succeed.
+BOOST_AUTO_TEST_CASE(reconnect_over_unix_socket, *boost::unit_test::precondition(server_has_unix_socket))
+{
+   net::io_context ioc;
+   unix_connection conn{ioc};
+
+   auto cfg = make_unix_config();
+   cfg.reconnect_wait_interval = 100ms;
+   cfg.health_check_interval = 200ms;
+
+   request req1;
+   req1.push("CLIENT", "ID");
+   req1.push("QUIT");
+
+   // Sent on the new connection even if written before the server
+   // closed the old one.
+   request req2;
+   req2.get_config().cancel_on_connection_lost = false;
+   req2.get_config().cancel_if_unresponded = false;
+   req2.push("CLIENT", "ID");
+
+   response<long long, redis::ignore_t> resp1;
+   response<long long> resp2;
+   response<long long> resp3;
+
+   net::steady_timer timer{ioc};
+   bool finished = false;
+
+   conn.async_exec(req1, resp1, [&](error_code ec, std::size_t) {
+      BOOST_TEST(!ec);
+      conn.async_exec(req2, resp2, [&](error_code ec, std::size_t) {
+         BOOST_TEST(!ec);
+
+         // Leaves time for a few health checks.
+         timer.expires_after(1s);
+         timer.async_wait([&](error_code) {
+            conn.async_exec(req2, resp3, [&](error_code ec, std::size_t) {
+               BOOST_TEST(!ec);
+               finished = true;
+               conn.cancel();
+            });
+         });
+      });
+   });
+
+   conn.async_run(cfg, {}, [](error_code) { });
+
+   ioc.run_for(10s);
+
+   BOOST_TEST(finished);
+   BOOST_TEST(std::get<0>(resp1).value() != std::get<0>(resp2).value());
+   BOOST_CHECK_EQUAL(std::get<0>(resp2).value(), std::get<0>(resp3).value());
+}
+
+BOOST_AUTO_TEST_CASE(unix_socket_not_set)
+{
+   net::io_context ioc;
+   unix_connection conn{ioc};
+
+   auto cfg = make_unix_config();
+   cfg.unix_socket.clear();
+   cfg.reconnect_wait_interval = 0s;
+
+   bool run_finished = false;
+   conn.async_run(cfg, {}, [&](error_code ec) {
+      run_finished = true;
+      BOOST_CHECK_EQUAL(ec, error::unix_socket_not_set);
+   });
+
+   ioc.run_for(10s);
+   BOOST_TEST(run_finished);
+}
+
+// Would make the endpoint constructor throw.
+BOOST_AUTO_TEST_CASE(unix_socket_path_too_long)
+{
+   net::io_context ioc;
+   unix_connection conn{ioc};
+
+   auto cfg = make_unix_config();
+   cfg.unix_socket = "/tmp/" + std::string(200, 'x') + ".sock";
+   cfg.reconnect_wait_interval = 0s;
+
+   bool run_finished = false;
+   conn.async_run(cfg, {}, [&](error_code ec) {
+      run_finished = true;
+      BOOST_CHECK_EQUAL(ec, error::unix_socket_path_too_long);
+   });
+
+   ioc.run_for(10s);
+   BOOST_TEST(run_finished);
+}
+
+BOOST_AUTO_TEST_CASE(unix_sockets_unsupported)
+{
+   net::io_context ioc;
+   tcp_connection conn{ioc};
+
+   auto cfg = make_unix_config();
+   cfg.reconnect_wait_interval = 0s;
+
+   bool run_finished = false;
+   conn.async_run(cfg, {}, [&](error_code ec) {
+      run_finished = true;
+      BOOST_CHECK_EQUAL(ec, error::unix_sockets_unsupported);
+   });
+
+   ioc.run_for(10s);
+   BOOST_TEST(run_finished);
+}
+
+#else
+
+BOOST_AUTO_TEST_CASE(dummy)
+{
+   BOOST_TEST(true);
+}
+
+#endif // BOOST_ASIO_HAS_LOCAL_SOCKETS
@@ -6,13 +6,25 @@
 
 #include <boost/redis/request.hpp>
 #include <boost/redis/response.hpp>
+#include <boost/redis/string_views.hpp>
 #include <boost/redis/adapter/adapt.hpp>
+#include <boost/redis/adapter/boost_containers.hpp>
 #include <boost/redis/resp3/parser.hpp>
+#include <boost/redis/detail/read_buffer.hpp>
+#include <boost/redis/detail/any_adapter.hpp>
 
+#include <boost/container/flat_map.hpp>
+#include <boost/container/flat_set.hpp>
+#include <boost/container/small_vector.hpp>
+#include <boost/container/static_vector.hpp>
 #define BOOST_TEST_MODULE low level
 #include <boost/test/included/unit_test.hpp>
 
 #include <map>
+// libc++ provides std::pmr from LLVM 16 on.
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+#endif
 #include <iostream>
 #include <optional>
 #include <sstream>
@@ -522,6 +534,8 @@ BOOST_AUTO_TEST_CASE(cover_error)
    check_error("boost.redis", boost::redis::error::ssl_handshake_timeout);
    check_error("boost.redis", boost::redis::error::sync_receive_push_failed);
    check_error("boost.redis", boost::redis::error::incompatible_node_depth);
+   check_error("boost.redis", boost::redis::error::unix_sockets_unsupported);
+   check_error("boost.redis", boost::redis::error::unix_socket_not_set);
 }
 
 std::string get_type_as_str(boost::redis::resp3::type t)
@@ -665,3 +679,849 @@ BOOST_AUTO_TEST_CASE(cancel_one_incompatible_depth)
 
    BOOST_CHECK_EQUAL(resp.value().size(), push_e1a.value().size());
 }
+
+BOOST_AUTO_TEST_CASE(crlf_scanners)
+{
+   using boost::redis::resp3::detail::crlf_scanner;
+   using boost::redis::resp3::detail::is_supported;
+   using boost::redis::resp3::detail::scan_crlf;
+
+   // Separators at block boundaries, a lone '\r' and a '\r' at the
+   // end that can't be decided yet.
+   std::string in(200, 'a');
+   std::vector<std::size_t> expected;
+   for (std::size_t i: {0, 15, 31, 47, 63, 100, 196}) {
+      in[i] = '\r';
+      in[i + 1] = '\n';
+      expected.push_back(i);
+   }
+   in[50] = '\r';
+   in[199] = '\r';
+
+   for (auto s: {crlf_scanner::scalar, crlf_scanner::sse2, crlf_scanner::avx2, crlf_scanner::neon}) {
+      if (!is_supported(s))
+         continue;
+
+      std::vector<std::size_t> out;
+      scan_crlf(s, in.data(), in.size(), 10, out);
+      BOOST_CHECK_EQUAL(out.size(), expected.size());
+      for (std::size_t i = 0; i < out.size() && i < expected.size(); ++i)
+         BOOST_CHECK_EQUAL(out[i], expected[i] + 10);
+   }
+}
+
+BOOST_AUTO_TEST_CASE(parse_pipeline_incrementally)
+{
+   using boost::redis::resp3::detail::crlf_scanner;
+   using boost::redis::resp3::detail::is_supported;
+   using boost::redis::resp3::detail::set_crlf_scanner;
+
+   // The bulk string contains a separator that must not be taken as
+   // the end of a line.
+   std::string const msg = "*3\r\n+PONG\r\n:42\r\n$4\r\na\r\nb\r\n";
+   std::size_t const n = 50;
+   std::string wire;
+   for (std::size_t i = 0; i < n; ++i)
+      wire += msg;
+
+   for (auto s: {crlf_scanner::scalar, crlf_scanner::sse2, crlf_scanner::avx2, crlf_scanner::neon}) {
+      if (!is_supported(s))
+         continue;
+
+      set_crlf_scanner(s);
+
+      // Data arrives one byte at a time and parsed messages are
+      // removed from the front of the buffer like connection does.
+      std::string buffer;
+      parser p;
+      std::size_t msgs = 0;
+      std::vector<resp3::node> nodes;
+      auto adapter = [&](auto const& nd, error_code&)
+         { nodes.push_back({nd.data_type, nd.aggregate_size, nd.depth, std::string{nd.value}}); };
+
+      for (char c: wire) {
+         buffer += c;
+         error_code ec;
+         while (!buffer.empty() && parse(p, buffer, adapter, ec)) {
+            BOOST_TEST(!ec);
+            BOOST_CHECK_EQUAL(p.get_consumed(), msg.size());
+            buffer.erase(0, p.get_consumed());
+            p.reset_for_next_message();
+            ++msgs;
+         }
+      }
+
+      BOOST_CHECK_EQUAL(msgs, n);
+      BOOST_CHECK_EQUAL(nodes.size(), 4 * n);
+      BOOST_CHECK_EQUAL(nodes.back().value, "a\r\nb");
+
+      // Whole pipeline in a single read.
+      buffer = wire;
+      msgs = 0;
+      p.reset();
+      error_code ec;
+      while (!buffer.empty() && parse(p, buffer, adapter, ec)) {
+         buffer.erase(0, p.get_consumed());
+         p.reset_for_next_message();
+         ++msgs;
+      }
+
+      BOOST_CHECK_EQUAL(msgs, n);
+   }
+
+   set_crlf_scanner(crlf_scanner::automatic);
+}
+
+BOOST_AUTO_TEST_CASE(read_buffer_consume_and_grow)
+{
+   using boost::redis::detail::read_buffer;
+
+   auto append = [](read_buffer& buf, std::string_view data)
+   {
+      auto const size = buf.size();
+      buf.grow(data.size());
+      auto const b = buf.data(size, data.size());
+      std::copy(std::cbegin(data), std::cend(data), static_cast<char*>(b.data()));
+   };
+
+   read_buffer buf;
+   append(buf, "+PONG\r\n+PONG\r\n+PO");
+   BOOST_CHECK_EQUAL(buf.size(), 17u);
+
+   buf.consume(7);
+   BOOST_CHECK_EQUAL(buf.view(), "+PONG\r\n+PO");
+
+   // More data is appended after the unconsumed bytes.
+   append(buf, "NG\r\n");
+   BOOST_CHECK_EQUAL(buf.view(), "+PONG\r\n+PONG\r\n");
+
+   // Data is read into an area larger than needed and shrunk
+   // afterwards.
+   buf.grow(100);
+   buf.shrink(100);
+   BOOST_CHECK_EQUAL(buf.view(), "+PONG\r\n+PONG\r\n");
+
+   // Consuming everything resets the buffer.
+   buf.consume(14);
+   BOOST_TEST(buf.empty());
+   BOOST_CHECK_EQUAL(buf.view(), "");
+}
+
+BOOST_AUTO_TEST_CASE(read_buffer_max_size)
+{
+   using boost::redis::detail::read_buffer;
+
+   read_buffer buf{10};
+   buf.grow(10);
+   buf.consume(5);
+   buf.grow(5);
+   BOOST_CHECK_EQUAL(buf.size(), 10u);
+   BOOST_CHECK_THROW(buf.grow(1), std::length_error);
+}
+
+BOOST_AUTO_TEST_CASE(read_buffer_release)
+{
+   using boost::redis::detail::read_buffer;
+
+   read_buffer buf;
+   buf.grow(1000);
+
+   // Not released while there is unconsumed data.
+   buf.consume(10);
+   BOOST_TEST(!buf.release_if_larger_than(100));
+   BOOST_TEST(buf.capacity() >= 1000u);
+
+   buf.consume(990);
+   BOOST_TEST(!buf.release_if_larger_than(1000));
+   BOOST_TEST(buf.capacity() >= 1000u);
+
+   BOOST_TEST(buf.release_if_larger_than(100));
+   BOOST_TEST(buf.capacity() < 1000u);
+   BOOST_TEST(buf.empty());
+}
+
+BOOST_AUTO_TEST_CASE(read_release_policy_waits_for_small_messages)
+{
+   using boost::redis::detail::read_release_policy;
+
+   read_release_policy policy;
+   std::size_t const limit = 1000;
+
+   // Large messages in a row never release the buffer.
+   for (int i = 0; i < 100; ++i)
+      BOOST_TEST(!policy.on_message(2 * limit, limit));
+
+   for (std::size_t i = 1; i < read_release_policy::small_messages; ++i)
+      BOOST_TEST(!policy.on_message(10, limit));
+
+   BOOST_TEST(policy.on_message(limit, limit));
+   BOOST_TEST(policy.on_message(10, limit));
+
+   // A large message starts over.
+   BOOST_TEST(!policy.on_message(limit + 1, limit));
+   BOOST_TEST(!policy.on_message(10, limit));
+}
+
+BOOST_AUTO_TEST_CASE(read_size_policy_adapts)
+{
+   using boost::redis::detail::read_size_policy;
+
+   read_size_policy p;
+   BOOST_CHECK_EQUAL(p.size(), read_size_policy::min_size);
+
+   // Full reads double the size up to the maximum.
+   for (int i = 0; i < 10; ++i)
+      p.on_read(p.size(), 65536);
+   BOOST_CHECK_EQUAL(p.size(), 65536u);
+
+   // Reads using between a quarter and all of it keep it.
+   p.on_read(20000, 65536);
+   BOOST_CHECK_EQUAL(p.size(), 65536u);
+
+   // Small reads halve it down to the minimum.
+   for (int i = 0; i < 10; ++i)
+      p.on_read(10, 65536);
+   BOOST_CHECK_EQUAL(p.size(), read_size_policy::min_size);
+
+   // The maximum never goes below the minimum.
+   p.on_read(p.size(), 0);
+   BOOST_CHECK_EQUAL(p.size(), read_size_policy::min_size);
+}
+
+BOOST_AUTO_TEST_CASE(bulk_in_chunks)
+{
+   using boost::redis::bulk_sink;
+   using boost::redis::adapter::boost_redis_adapt;
+
+   std::string received;
+   std::size_t calls = 0;
+   response<bulk_sink, std::string> resp{
+      bulk_sink{[&](std::size_t offset, std::string_view chunk, error_code&) {
+         BOOST_CHECK_EQUAL(offset, received.size());
+         received += chunk;
+         ++calls;
+      }}, std::string{}};
+
+   auto f = boost_redis_adapt(resp);
+   BOOST_TEST(f.supports_bulk_chunks(0));
+   BOOST_TEST(f.supports_bulk_chunks(1));
+
+   std::string const value = "0123456789abcdefghij";
+   std::string const wire = "$20\r\n" + value + "\r\n$3\r\nfoo\r\n";
+
+   // Data arrives three bytes at a time and, as the connection does,
+   // chunks are discarded from the buffer once passed on.
+   parser p;
+   std::string buffer;
+   std::size_t max_buffer = 0;
+   for (std::size_t i = 0, msg = 0; msg < 2;) {
+      if (i < wire.size()) {
+         buffer += wire.substr(i, 3);
+         i += 3;
+      }
+
+      max_buffer = (std::max)(max_buffer, buffer.size());
+
+      p.set_bulk_chunk_size(msg == 0 ? 4 : 0);
+      auto adapter = [&](auto const& nd, error_code& ec) { f(msg, nd, ec); };
+
+      error_code ec;
+      if (parse(p, buffer, adapter, ec)) {
+         BOOST_TEST(!ec);
+         buffer.erase(0, p.get_consumed());
+         p.reset_for_next_message();
+         ++msg;
+      } else if (p.is_chunking()) {
+         buffer.erase(0, p.get_consumed());
+         p.discard_consumed();
+      }
+   }
+
+   BOOST_CHECK_EQUAL(received, value);
+   BOOST_CHECK_EQUAL(std::get<0>(resp).value().size(), value.size());
+   BOOST_TEST(calls > 2u);
+   BOOST_TEST(max_buffer < value.size());
+   BOOST_CHECK_EQUAL(std::get<1>(resp).value(), "foo");
+}
+
+// Blob strings received in chunks produce the same nodes as the
+// equivalent streamed string.
+BOOST_AUTO_TEST_CASE(chunked_blob_matches_streamed_string)
+{
+   auto parse_nodes = [](std::string_view wire, std::size_t chunk_size) {
+      generic_response resp;
+      auto f = adapt2(resp);
+      parser p;
+      p.set_bulk_chunk_size(chunk_size);
+      error_code ec;
+      BOOST_TEST(parse(p, wire, f, ec));
+      BOOST_TEST(!ec);
+      return resp.value();
+   };
+
+   auto check = [&](std::string_view blob, std::string_view streamed) {
+      auto const chunked = parse_nodes(blob, 4);
+      auto const expected = parse_nodes(streamed, 0);
+      BOOST_CHECK_EQUAL(chunked.size(), expected.size());
+      BOOST_TEST(bool(chunked == expected));
+   };
+
+   check("$11\r\nhello world\r\n", "$?\r\n;11\r\nhello world\r\n;0\r\n");
+   check("*2\r\n$11\r\nhello world\r\n:1\r\n", "*2\r\n$?\r\n;11\r\nhello world\r\n;0\r\n:1\r\n");
+}
+
+BOOST_AUTO_TEST_CASE(bulk_sink_without_chunks)
+{
+   using boost::redis::bulk_sink;
+
+   std::string received;
+   std::size_t calls = 0;
+   result<bulk_sink> resp{bulk_sink{[&](std::size_t, std::string_view chunk, error_code&) {
+      received += chunk;
+      ++calls;
+   }}};
+
+   error_code ec;
+   parser p;
+   auto f = adapt2(resp);
+   BOOST_TEST(parse(p, "$5\r\nhello\r\n", f, ec));
+   BOOST_TEST(!ec);
+   BOOST_CHECK_EQUAL(received, "hello");
+
+   // The last call has an empty chunk.
+   BOOST_CHECK_EQUAL(calls, 2u);
+}
+
+BOOST_AUTO_TEST_CASE(bulk_destination)
+{
+   using boost::redis::adapter::boost_redis_adapt;
+
+   response<std::string, int, std::vector<std::string>> resp;
+   auto f = boost_redis_adapt(resp);
+
+   BOOST_TEST(f.supports_bulk_chunks(0));
+   BOOST_TEST(!f.supports_bulk_chunks(1));
+   BOOST_TEST(!f.supports_bulk_chunks(2));
+
+   auto* p = f.bulk_destination(0, 5);
+   BOOST_TEST(p != nullptr);
+   std::copy_n("hello", 5, p);
+   BOOST_CHECK_EQUAL(std::get<0>(resp).value(), "hello");
+
+   BOOST_TEST(f.bulk_destination(1, 5) == nullptr);
+   BOOST_TEST(f.bulk_destination(2, 5) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(string_from_chunks)
+{
+   // Without a destination the parts are appended.
+   result<std::string> resp;
+   auto f = adapt2(resp);
+
+   error_code ec;
+   parser p;
+   p.set_bulk_chunk_size(4);
+   BOOST_TEST(parse(p, "$10\r\n0123456789\r\n", f, ec));
+   BOOST_TEST(!ec);
+   BOOST_CHECK_EQUAL(resp.value(), "0123456789");
+}
+
+BOOST_AUTO_TEST_CASE(any_adapter_parse)
+{
+   using boost::redis::adapter::boost_redis_adapt;
+   using boost::redis::detail::any_adapter;
+
+   response<int, std::vector<std::string>> resp;
+   any_adapter f;
+   f.emplace(boost_redis_adapt(resp));
+
+   error_code ec;
+   parser p;
+   BOOST_TEST(f.parse(0, p, ":3\r\n", ec));
+   BOOST_TEST(!ec);
+   BOOST_CHECK_EQUAL(std::get<0>(resp).value(), 3);
+
+   // The second message arrives in two reads.
+   std::string_view const wire = "*3\r\n$3\r\none\r\n$3\r\ntwo\r\n$5\r\nthree\r\n";
+   p.reset();
+   BOOST_TEST(!f.parse(1, p, wire.substr(0, 20), ec));
+   BOOST_TEST(f.parse(1, p, wire, ec));
+   BOOST_TEST(!ec);
+   BOOST_CHECK_EQUAL(p.get_consumed(), wire.size());
+
+   std::vector<std::string> const expected{"one", "two", "three"};
+   BOOST_CHECK_EQUAL_COLLECTIONS(
+      std::cbegin(std::get<1>(resp).value()), std::cend(std::get<1>(resp).value()),
+      std::cbegin(expected), std::cend(expected));
+
+   // Adapters of a single response ignore the index.
+   generic_response gresp;
+   f.emplace(boost_redis_adapt(gresp));
+   p.reset();
+   BOOST_TEST(f.parse(0, p, wire, ec));
+   BOOST_TEST(!ec);
+   BOOST_CHECK_EQUAL(gresp.value().size(), 4u);
+
+   // Errors stop the parse loop.
+   f.emplace(boost_redis_adapt(ignore));
+   p.reset();
+   BOOST_TEST(f.parse(0, p, "-ERR\r\n", ec));
+   BOOST_CHECK_EQUAL(ec, error::resp3_simple_error);
+}
+
+namespace capacity {
+
+struct item {
+   std::string value;
+};
+
+std::size_t reserved = 0;
+
+void boost_redis_from_bulk(item& i, std::string_view sv, error_code&)
+   { i.value = sv; }
+
+void boost_redis_reserve(std::vector<item>& v, std::size_t n)
+{
+   reserved = n;
+   v.reserve(n);
+}
+
+} // capacity
+
+BOOST_AUTO_TEST_CASE(containers_from_aggregate_size)
+{
+   std::string_view const wire = "%3\r\n$1\r\nb\r\n$1\r\n1\r\n$1\r\na\r\n$1\r\n2\r\n$1\r\nb\r\n$1\r\n3\r\n";
+
+   // Repeated keys keep the last value.
+   {
+      result<std::map<std::string, std::string>> resp;
+      auto f = adapt2(resp);
+      error_code ec;
+      parser p;
+      BOOST_TEST(parse(p, wire, f, ec));
+      BOOST_TEST(!ec);
+      std::map<std::string, std::string> const expected{{"a", "2"}, {"b", "3"}};
+      BOOST_TEST(bool(resp.value() == expected));
+   }
+
+   {
+      result<std::unordered_map<std::string, std::string>> resp;
+      auto f = adapt2(resp);
+      error_code ec;
+      parser p;
+      BOOST_TEST(parse(p, wire, f, ec));
+      BOOST_TEST(!ec);
+      std::unordered_map<std::string, std::string> const expected{{"a", "2"}, {"b", "3"}};
+      BOOST_TEST(bool(resp.value() == expected));
+   }
+
+   // Values of the same key keep the order they were received in.
+   {
+      result<std::multimap<std::string, std::string>> resp;
+      auto f = adapt2(resp);
+      error_code ec;
+      parser p;
+      BOOST_TEST(parse(p, wire, f, ec));
+      BOOST_TEST(!ec);
+      std::multimap<std::string, std::string> const expected{{"a", "2"}, {"b", "1"}, {"b", "3"}};
+      BOOST_TEST(bool(resp.value() == expected));
+   }
+
+   // User containers are reserved through boost_redis_reserve.
+   {
+      result<std::vector<capacity::item>> resp;
+      auto f = adapt2(resp);
+      error_code ec;
+      parser p;
+      BOOST_TEST(parse(p, "*3\r\n$1\r\na\r\n$1\r\nb\r\n$1\r\nc\r\n", f, ec));
+      BOOST_TEST(!ec);
+      BOOST_CHECK_EQUAL(capacity::reserved, 3u);
+      BOOST_CHECK_EQUAL(resp.value().size(), 3u);
+   }
+}
+
+namespace custom {
+
+// A container that is not known to the library.
+struct bag {
+   using value_type = std::string;
+   std::vector<std::string> items;
+
+   auto size() const noexcept { return items.size(); }
+   auto max_size() const noexcept { return items.max_size(); }
+   void push_back(std::string s) { items.push_back(std::move(s)); }
+   auto& back() { return items.back(); }
+};
+
+} // custom
+
+template <>
+struct boost::redis::adapter::container_category<custom::bag> {
+   using type = boost::redis::adapter::sequence_container_tag;
+};
+
+BOOST_AUTO_TEST_CASE(boost_and_custom_containers)
+{
+   namespace container = boost::container;
+
+   std::string_view const map_wire = "%3\r\n$1\r\nb\r\n$1\r\n1\r\n$1\r\na\r\n$1\r\n2\r\n$1\r\nb\r\n$1\r\n3\r\n";
+   std::string_view const set_wire = "~3\r\n$1\r\nc\r\n$1\r\na\r\n$1\r\nb\r\n";
+   std::string_view const array_wire = "*3\r\n$1\r\na\r\n$1\r\nb\r\n$1\r\nc\r\n";
+
+   auto parse_into = [](auto& resp, std::string_view wire) {
+      auto f = adapt2(resp);
+      error_code ec;
+      parser p;
+      BOOST_TEST(parse(p, wire, f, ec));
+      return ec;
+   };
+
+   {
+      result<container::flat_map<std::string, std::string>> resp;
+      BOOST_TEST(!parse_into(resp, map_wire));
+      container::flat_map<std::string, std::string> const expected{{"a", "2"}, {"b", "3"}};
+      BOOST_TEST(bool(resp.value() == expected));
+   }
+
+   {
+      result<container::flat_set<std::string>> resp;
+      BOOST_TEST(!parse_into(resp, set_wire));
+      container::flat_set<std::string> const expected{"a", "b", "c"};
+      BOOST_TEST(bool(resp.value() == expected));
+   }
+
+   {
+      result<container::small_vector<std::string, 4>> resp;
+      BOOST_TEST(!parse_into(resp, array_wire));
+      BOOST_CHECK_EQUAL(resp.value().size(), 3u);
+      BOOST_CHECK_EQUAL(resp.value().back(), "c");
+   }
+
+   {
+      result<container::static_vector<std::string, 3>> resp;
+      BOOST_TEST(!parse_into(resp, array_wire));
+      BOOST_CHECK_EQUAL(resp.value().size(), 3u);
+   }
+
+   // Replies larger than a fixed capacity are an error.
+   {
+      result<container::static_vector<std::string, 2>> resp;
+      BOOST_CHECK_EQUAL(parse_into(resp, array_wire), error::incompatible_size);
+   }
+
+   {
+      result<custom::bag> resp;
+      BOOST_TEST(!parse_into(resp, array_wire));
+      std::vector<std::string> const expected{"a", "b", "c"};
+      BOOST_TEST(bool(resp.value().items == expected));
+   }
+}
+
+// Values longer than the small string buffer, so that they allocate.
+auto make_long(char c)
+   { return std::string(40, c); }
+
+#if defined(__cpp_lib_memory_resource)
+
+BOOST_AUTO_TEST_CASE(pmr_containers)
+{
+   auto const bulk = [](std::string const& s)
+      { return "$" + std::to_string(s.size()) + "\r\n" + s + "\r\n"; };
+
+   auto const map_wire = "%2\r\n" + bulk(make_long('b')) + bulk(make_long('1')) + bulk(make_long('a')) + bulk(make_long('2'));
+   auto const set_wire = "~2\r\n" + bulk(make_long('b')) + bulk(make_long('a'));
+   auto const array_wire = "*2\r\n" + bulk(make_long('a')) + bulk(make_long('b'));
+
+   std::pmr::monotonic_buffer_resource arena;
+
+   // Nothing is allocated from the default resource.
+   auto* const prev = std::pmr::set_default_resource(std::pmr::null_memory_resource());
+
+   auto parse_into = [](auto& resp, std::string_view wire) {
+      auto f = adapt2(resp);
+      error_code ec;
+      parser p;
+      BOOST_TEST(parse(p, wire, f, ec));
+      return ec;
+   };
+
+   result<std::pmr::vector<std::pmr::string>> vec{std::pmr::vector<std::pmr::string>{&arena}};
+   BOOST_TEST(!parse_into(vec, array_wire));
+
+   result<std::pmr::map<std::pmr::string, std::pmr::string>> map{std::pmr::map<std::pmr::string, std::pmr::string>{&arena}};
+   BOOST_TEST(!parse_into(map, map_wire));
+
+   result<std::pmr::unordered_map<std::pmr::string, std::pmr::string>> umap{std::pmr::unordered_map<std::pmr::string, std::pmr::string>{&arena}};
+   BOOST_TEST(!parse_into(umap, map_wire));
+
+   result<std::pmr::set<std::pmr::string>> set{std::pmr::set<std::pmr::string>{&arena}};
+   BOOST_TEST(!parse_into(set, set_wire));
+
+   std::pmr::set_default_resource(prev);
+
+   BOOST_CHECK_EQUAL(vec.value().size(), 2u);
+   BOOST_TEST(std::string_view{vec.value().front()} == make_long('a'));
+   BOOST_TEST(vec.value().get_allocator().resource() == &arena);
+   BOOST_TEST(vec.value().front().get_allocator().resource() == &arena);
+
+   BOOST_CHECK_EQUAL(map.value().size(), 2u);
+   BOOST_TEST(std::string_view{map.value().begin()->first} == make_long('a'));
+   BOOST_TEST(std::string_view{map.value().begin()->second} == make_long('2'));
+
+   BOOST_CHECK_EQUAL(umap.value().size(), 2u);
+   BOOST_TEST(std::string_view{umap.value().at(std::pmr::string{make_long('b')})} == make_long('1'));
+
+   BOOST_CHECK_EQUAL(set.value().size(), 2u);
+   BOOST_TEST(std::string_view{*set.value().begin()} == make_long('a'));
+}
+
+#endif // defined(__cpp_lib_memory_resource)
+
+BOOST_AUTO_TEST_CASE(string_views_response)
+{
+   using boost::redis::string_views;
+   using boost::redis::string_arena;
+
+   auto parse_into = [](auto& resp, std::string_view wire) {
+      auto f = adapt2(resp);
+      error_code ec;
+      parser p;
+      BOOST_TEST(parse(p, wire, f, ec));
+      return ec;
+   };
+
+   std::string wire = "*3\r\n";
+   for (auto c: {'a', 'b', 'c'})
+      wire += "$40\r\n" + make_long(c) + "\r\n";
+
+   result<string_views<>> vec;
+   BOOST_TEST(!parse_into(vec, wire));
+   BOOST_CHECK_EQUAL(vec.value().size(), 3u);
+   BOOST_CHECK_EQUAL(vec.value().get_arena().size(), 120u);
+
+   // All values in one block.
+   BOOST_CHECK_EQUAL(vec.value().get_arena().capacity(), 4096u);
+
+   // Views don't point into the input and survive moves of the
+   // response.
+   wire.assign(wire.size(), '-');
+   auto moved = std::move(vec.value());
+   auto const a = make_long('a'), b = make_long('b'), c = make_long('c');
+   std::vector<std::string_view> const expected{a, b, c};
+   BOOST_TEST(bool(moved.get() == expected));
+
+   result<string_views<std::unordered_map<std::string_view, std::string_view>>> map;
+   BOOST_TEST(!parse_into(map, "%2\r\n$1\r\na\r\n$1\r\n1\r\n$1\r\nb\r\n$1\r\n2\r\n"));
+   BOOST_CHECK_EQUAL(map.value().size(), 2u);
+   BOOST_CHECK_EQUAL(map.value().get().at("b"), "2");
+
+   result<string_views<std::set<std::string_view>>> set;
+   BOOST_TEST(!parse_into(set, "~2\r\n$1\r\nb\r\n$1\r\na\r\n"));
+   BOOST_CHECK_EQUAL(*set.value().begin(), "a");
+
+   // Values larger than a block get their own.
+   string_arena arena;
+   auto const v = arena.store(std::string(10'000, 'x'));
+   BOOST_CHECK_EQUAL(v.size(), 10'000u);
+   BOOST_CHECK_EQUAL(arena.capacity(), 10'000u);
+   arena.store("y");
+   BOOST_CHECK_EQUAL(arena.capacity(), 30'000u);
+   arena.clear();
+   BOOST_CHECK_EQUAL(arena.size(), 0u);
+   BOOST_CHECK_EQUAL(arena.capacity(), 20'000u);
+}
+
+BOOST_AUTO_TEST_CASE(flat_response_matches_generic_response)
+{
+   using boost::redis::flat_response;
+   using boost::redis::adapter::boost_redis_adapt;
+
+   std::string const wire = "%2\r\n$4\r\nkey1\r\n$6\r\nvalue1\r\n+key2\r\n*2\r\n:1\r\n$0\r\n\r\n";
+
+   generic_response gresp;
+   flat_response fresp;
+
+   for (int i = 0; i < 2; ++i) {
+      // The second round checks memory is reused after clear.
+      gresp.value().clear();
+      fresp.value().clear();
+
+      error_code ec;
+      parser p1;
+      auto f1 = adapt2(gresp);
+      BOOST_TEST(parse(p1, wire, f1, ec));
+      BOOST_TEST(!ec);
+
+      parser p2;
+      auto f2 = boost_redis_adapt(fresp);
+      auto g2 = [&](auto const& nd, error_code& ec2) { f2(0, nd, ec2); };
+      BOOST_TEST(parse(p2, wire, g2, ec));
+      BOOST_TEST(!ec);
+   }
+
+   auto const& tape = fresp.value();
+   BOOST_CHECK_EQUAL(tape.size(), gresp.value().size());
+   BOOST_CHECK_EQUAL(tape.get_data(), "key1value1key21");
+
+   std::size_t i = 0;
+   for (auto const& nd: tape) {
+      auto const& expected = gresp.value().at(i++);
+      BOOST_CHECK_EQUAL(nd.data_type, expected.data_type);
+      BOOST_CHECK_EQUAL(nd.aggregate_size, expected.aggregate_size);
+      BOOST_CHECK_EQUAL(nd.depth, expected.depth);
+      BOOST_CHECK_EQUAL(nd.value, expected.value);
+   }
+
+   BOOST_CHECK_EQUAL(tape.value(2), "value1");
+   BOOST_CHECK_EQUAL(std::distance(tape.begin(), tape.end()), 7);
+   BOOST_CHECK_EQUAL(tape.begin()[3].value, "key2");
+   BOOST_CHECK_EQUAL(tape.begin()->data_type, resp3::type::map);
+   BOOST_CHECK_THROW((void)tape.at(7), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(flat_response_error)
+{
+   boost::redis::flat_response resp;
+   auto f = adapt2(resp);
+
+   parser p;
+   error_code ec;
+   BOOST_TEST(parse(p, std::string{"-Error\r\n"}, f, ec));
+   BOOST_TEST(resp.has_error());
+   BOOST_CHECK_EQUAL(resp.error().diagnostic, "Error");
+}
+
+BOOST_AUTO_TEST_CASE(raw_response_records_wire_bytes)
+{
+   using boost::redis::adapter::boost_redis_adapt;
+   using boost::redis::detail::any_adapter;
+
+   std::string_view const hash = "%2\r\n$2\r\nk1\r\n:1\r\n$2\r\nk2\r\n:2\r\n";
+   std::string_view const err = "-ERR unknown\r\n";
+   std::string_view const set = "~2\r\n+a\r\n+b\r\n";
+
+   // Several replies in the same buffer, as read by the connection.
+   std::string wire{hash};
+   wire += err;
+   wire += set;
+
+   boost::redis::raw_response resp;
+   any_adapter f;
+   f.emplace(boost_redis_adapt(resp));
+
+   error_code ec;
+   parser p;
+   std::string_view data = wire;
+
+   // The first reply arrives in two reads.
+   BOOST_TEST(!f.parse(0, p, data.substr(0, 20), ec));
+   BOOST_TEST(resp.value().empty());
+
+   for (std::size_t i = 0; i < 3; ++i) {
+      BOOST_TEST(f.parse(i, p, data, ec));
+      BOOST_TEST(!ec);
+      data.remove_prefix(p.get_consumed());
+      p.reset_for_next_message();
+   }
+
+   // Error replies are kept as any other reply.
+   BOOST_TEST(!resp.has_error());
+
+   auto const& tape = resp.value();
+   BOOST_CHECK_EQUAL(tape.size(), 3u);
+   BOOST_CHECK_EQUAL(tape[0], hash);
+   BOOST_CHECK_EQUAL(tape[1], err);
+   BOOST_CHECK_EQUAL(tape[2], set);
+   BOOST_CHECK_EQUAL(tape.get_data(), wire);
+
+   // Decoding on demand.
+   result<std::map<std::string, int>> fields;
+   tape.decode(0, adapt2(fields));
+   BOOST_CHECK_EQUAL(fields.value().size(), 2u);
+   BOOST_CHECK_EQUAL(fields.value().at("k1"), 1);
+   BOOST_CHECK_EQUAL(fields.value().at("k2"), 2);
+
+   generic_response gresp;
+   tape.decode(2, adapt2(gresp), ec);
+   BOOST_TEST(!ec);
+   BOOST_CHECK_EQUAL(gresp.value().size(), 3u);
+
+   result<std::string> str;
+   tape.decode(1, adapt2(str), ec);
+   BOOST_TEST(str.has_error());
+   BOOST_CHECK_EQUAL(str.error().diagnostic, "ERR unknown");
+
+   // The element of a response with several elements.
+   response<boost::redis::resp3::raw_tape, std::string> resp2;
+   f.emplace(boost_redis_adapt(resp2));
+   p.reset();
+   BOOST_TEST(f.parse(0, p, set, ec));
+   BOOST_TEST(!ec);
+   BOOST_CHECK_EQUAL(std::get<0>(resp2).value().get_data(), set);
+
+   resp.value().clear();
+   BOOST_TEST(resp.value().empty());
+   BOOST_CHECK_EQUAL(resp.value().get_data(), "");
+}
+
+BOOST_AUTO_TEST_CASE(queue_response_consume)
+{
+   using boost::redis::queue_response;
+
+   queue_response resp;
+   auto f = adapt2(resp);
+
+   auto push = [&](std::string const& wire)
+   {
+      parser p;
+      error_code ec;
+      BOOST_TEST(parse(p, wire, f, ec));
+      BOOST_TEST(!ec);
+   };
+
+   for (int round = 0; round < 2; ++round) {
+      push(">3\r\n+message\r\n+channel\r\n+one\r\n");
+      push(">3\r\n+message\r\n+channel\r\n+two\r\n");
+
+      BOOST_CHECK_EQUAL(resp.value().size(), 2u);
+      auto msg = resp.value().front();
+      BOOST_CHECK_EQUAL(msg.size(), 4u);
+      BOOST_CHECK_EQUAL(msg[0].data_type, resp3::type::push);
+      BOOST_CHECK_EQUAL(msg[3].value, "one");
+      consume_one(resp);
+
+      // The reader appends while the front is consumed.
+      push(">3\r\n+message\r\n+channel\r\n+three\r\n");
+      BOOST_CHECK_EQUAL(resp.value().size(), 2u);
+      BOOST_CHECK_EQUAL(resp.value().front()[3].value, "two");
+      consume_one(resp);
+      BOOST_CHECK_EQUAL(resp.value().front()[3].value, "three");
+      consume_one(resp);
+
+      BOOST_TEST(resp.value().empty());
+      BOOST_TEST(resp.value().get_tape().empty());
+
+      // Nothing to consume.
+      consume_one(resp);
+   }
+}
+
+BOOST_AUTO_TEST_CASE(queue_response_never_drained)
+{
+   boost::redis::resp3::node_queue q;
+   using node = resp3::basic_node<std::string_view>;
+
+   // Keeps one message pending at all times so that memory is only
+   // reclaimed by compaction.
+   q.push_back(node{resp3::type::simple_string, 1, 0, "0"});
+   for (int i = 1; i < 1000; ++i) {
+      auto const s = std::to_string(i);
+      q.push_back(node{resp3::type::simple_string, 1, 0, s});
+      BOOST_CHECK_EQUAL(q.front()[0].value, std::to_string(i - 1));
+      q.pop();
+      BOOST_CHECK_EQUAL(q.size(), 1u);
+   }
+
+   BOOST_CHECK_EQUAL(q.get_tape().size(), 1u);
+   BOOST_CHECK_EQUAL(q.front()[0].value, "999");
+}
@@ -51,3 +51,146 @@ BOOST_AUTO_TEST_CASE(container_and_range)
    req2.push_range("HSET", "key", std::cbegin(in), std::cend(in));
    BOOST_CHECK_EQUAL(req2.payload(), std::string{res});
 }
+
+BOOST_AUTO_TEST_CASE(push_ref_references_large_args)
+{
+   std::string const blob(1000, 'a');
+
+   request expected;
+   expected.push("SET", "key", blob);
+   expected.push("PING");
+
+   request req;
+   req.push_ref("SET", "key", blob);
+   req.push("PING");
+
+   BOOST_CHECK_EQUAL(req.size(), std::size(expected.payload()));
+
+   std::string joined;
+   bool referenced = false;
+   req.for_each_fragment([&](std::string_view frag) {
+      joined += frag;
+      referenced = referenced || std::data(frag) == std::data(blob);
+   });
+
+   BOOST_TEST(referenced);
+   BOOST_CHECK_EQUAL(joined, expected.payload());
+   BOOST_CHECK_EQUAL(req.payload(), expected.payload());
+
+   // The materialized payload is invalidated when the request changes.
+   req.push("PING");
+   expected.push("PING");
+   BOOST_CHECK_EQUAL(req.payload(), expected.payload());
+
+   req.clear();
+   req.push("PING");
+   BOOST_CHECK_EQUAL(req.payload(), std::string{"*1\r\n$4\r\nPING\r\n"});
+}
+
+BOOST_AUTO_TEST_CASE(command_template_matches_push)
+{
+   using boost::redis::command_template;
+
+   constexpr command_template<4> set_ex{"SET"};
+   static_assert(set_ex.prefix() == "*5\r\n$3\r\nSET\r\n");
+
+   constexpr command_template<0> ping{"PING"};
+   constexpr command_template<1> subscribe{"SUBSCRIBE"};
+
+   request expected;
+   expected.push("SET", "key", "value", "EX", 2);
+   expected.push("PING");
+   expected.push("SUBSCRIBE", "channel");
+
+   request req;
+   req.push(set_ex, "key", "value", "EX", 2);
+   req.push(ping);
+   req.push(subscribe, "channel");
+
+   BOOST_CHECK_EQUAL(req.payload(), expected.payload());
+   BOOST_CHECK_EQUAL(req.get_commands(), 3u);
+   BOOST_CHECK_EQUAL(req.get_expected_responses(), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(command_catalog)
+{
+   namespace cmd = boost::redis::cmd;
+
+   static_assert(cmd::get.is_readonly() && !cmd::get.is_write());
+   static_assert(cmd::blpop.is_blocking() && cmd::blpop.last_key == -2);
+   static_assert(cmd::mset.key_step == 2);
+   static_assert(cmd::ssubscribe.responses == 0 && cmd::ssubscribe.has_keys());
+
+   request expected;
+   expected.push("HELLO", 3);
+   expected.push("SET", "key", "value", "EX", 2);
+   expected.push("GET", "key");
+   expected.push("SSUBSCRIBE", "channel");
+
+   request req;
+   req.push(cmd::hello, 3);
+   req.push(cmd::set, "key", "value", "EX", 2);
+   req.push(cmd::get, "key");
+   req.push(cmd::ssubscribe, "channel");
+
+   BOOST_CHECK_EQUAL(req.payload(), expected.payload());
+   BOOST_CHECK_EQUAL(req.get_commands(), 4u);
+   BOOST_CHECK_EQUAL(req.get_expected_responses(), 3u);
+   BOOST_CHECK_EQUAL(expected.get_expected_responses(), 3u);
+   BOOST_TEST(req.has_hello_priority());
+}
+
+BOOST_AUTO_TEST_CASE(sharded_and_pattern_unsubscribe_have_no_response)
+{
+   request req;
+   req.push("SSUBSCRIBE", "channel");
+   req.push("SUNSUBSCRIBE", "channel");
+   req.push("PUNSUBSCRIBE", "pattern");
+   BOOST_CHECK_EQUAL(req.get_expected_responses(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(arg_numbers)
+{
+   request req;
+   req.push("ZADD", "key", 1.5, "a", -0.1, "b", 1e300, "c");
+   req.push("INCRBY", "key", -9223372036854775807LL - 1);
+   req.push("PING", 18446744073709551615ULL, true, 0);
+
+   char const* res =
+      "*8\r\n$4\r\nZADD\r\n$3\r\nkey\r\n$3\r\n1.5\r\n$1\r\na\r\n$4\r\n-0.1\r\n$1\r\nb\r\n$6\r\n1e+300\r\n$1\r\nc\r\n"
+      "*3\r\n$6\r\nINCRBY\r\n$3\r\nkey\r\n$20\r\n-9223372036854775808\r\n"
+      "*4\r\n$4\r\nPING\r\n$20\r\n18446744073709551615\r\n$1\r\n1\r\n$1\r\n0\r\n";
+
+   BOOST_CHECK_EQUAL(req.payload(), std::string{res});
+}
+
+BOOST_AUTO_TEST_CASE(serialized_size_hint)
+{
+   std::string const value(1000, 'a');
+
+   request req1;
+   req1.push("SET", "key", value);
+   BOOST_CHECK_EQUAL(request::serialized_size_hint("SET", "key", value), req1.size());
+
+   // An upper bound for numbers.
+   request req2;
+   req2.push("INCRBY", "key", 42);
+   BOOST_TEST(request::serialized_size_hint("INCRBY", "key", 42) >= req2.size());
+
+   // Range sizing.
+   std::vector<std::string> members;
+   for (int i = 0; i < 1000; ++i)
+      members.push_back("member:" + std::to_string(i));
+
+   request req3;
+   req3.push_range("SADD", "key", members);
+
+   using boost::redis::resp3::header_size;
+   auto const bulk_size = [](std::string_view sv) { return header_size(sv.size()) + sv.size() + 2; };
+
+   auto expected = header_size(2 + members.size()) + bulk_size("SADD") + bulk_size("key");
+   for (auto const& m: members)
+      expected += bulk_size(m);
+
+   BOOST_CHECK_EQUAL(req3.size(), expected);
+}